@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "events/event.hpp"
+#include "events/dispatcher.hpp"
+#include "events/handler.hpp"
+
+// Usage: events_benchmark [name-filter] [iteration-scale]
+
+// =============================================================================
+// Allocation counting
+// =============================================================================
+
+// Every replaceable global new/delete is routed through one pair of helpers:
+// plain forms use malloc/free, aligned forms aligned_alloc/free, so each
+// allocation is counted exactly once and freed by its matching function.
+
+namespace {
+
+std::atomic<size_t> allocation_count{0};
+
+void* counted_alloc(std::size_t size, std::size_t alignment) noexcept {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return std::malloc(size);
+    }
+    // aligned_alloc wants the size to be a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* counted_alloc_or_throw(std::size_t size, std::size_t alignment) {
+    if (void* ptr = counted_alloc(size, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return counted_alloc_or_throw(size, 0);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_alloc_or_throw(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return counted_alloc_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return counted_alloc_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size, 0);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_alloc(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_alloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+namespace {
+
+using namespace temp2::events;
+using Clock = std::chrono::steady_clock;
+
+// =============================================================================
+// Harness
+// =============================================================================
+
+std::string filter;
+double scale = 1.0;
+std::atomic<uint64_t> sink{0};
+
+size_t scaled(size_t iterations) {
+    return std::max<size_t>(1, static_cast<size_t>(static_cast<double>(iterations) * scale));
+}
+
+// Runs body(iterations) once to warm up and once measured; body must perform iterations ops
+template <typename Body>
+void run(const std::string& name, size_t iterations, Body&& body) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+    iterations = scaled(iterations);
+    body(std::max<size_t>(1, iterations / 10));
+
+    size_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+    auto start = Clock::now();
+    body(iterations);
+    auto elapsed = Clock::now() - start;
+    size_t allocations = allocation_count.load(std::memory_order_relaxed) - allocations_before;
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    std::cout << std::left << std::setw(44) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1) << ns / static_cast<double>(iterations)
+              << " ns/op" << std::setw(12) << std::setprecision(3)
+              << static_cast<double>(allocations) / static_cast<double>(iterations) << " allocs/op\n";
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+
+void bench_subscribe() {
+    run("subscribe/one_type", 2000, [](size_t n) {
+        EventDispatcher dispatcher;
+        for (size_t i = 0; i < n; ++i) {
+            dispatcher.subscribe("bench.subscribe", [](Event&) {});
+        }
+    });
+
+    run("subscribe/distinct_types", 2000, [](size_t n) {
+        EventDispatcher dispatcher;
+        for (size_t i = 0; i < n; ++i) {
+            dispatcher.subscribe("bench.subscribe." + std::to_string(i % 64), [](Event&) {});
+        }
+    });
+}
+
+void bench_dispatch() {
+    for (size_t handlers : {1, 10, 100}) {
+        EventDispatcher dispatcher;
+        uint64_t calls = 0;
+        for (size_t i = 0; i < handlers; ++i) {
+            dispatcher.subscribe("mouse", [&calls](Event&) { ++calls; });
+        }
+
+        MouseEvent event(MouseEvent::Action::Move, 1.0, 2.0);
+        run("dispatch/" + std::to_string(handlers) + "_handlers", 2000000 / handlers, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                dispatcher.dispatch(event);
+            }
+        });
+        sink += calls;
+    }
+
+    EventDispatcher dispatcher;
+    MouseEvent event(MouseEvent::Action::Move, 1.0, 2.0);
+    run("dispatch/no_handlers", 2000000, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            dispatcher.dispatch(event);
+        }
+    });
+}
+
+void bench_queue() {
+    EventDispatcher dispatcher;
+    uint64_t calls = 0;
+    dispatcher.subscribe("mouse", [&calls](Event&) { ++calls; });
+
+    run("queue/single_thread", 1000000, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            dispatcher.queue_event(std::make_unique<MouseEvent>(MouseEvent::Action::Move, 1.0, 2.0));
+            if ((i & 255) == 255) {
+                dispatcher.process_queue();
+            }
+        }
+        dispatcher.process_queue();
+    });
+
+    size_t max_producers = std::max<size_t>(2, std::thread::hardware_concurrency());
+    for (size_t producers = 1; producers <= max_producers; producers *= 2) {
+        for (QueueMode mode : {QueueMode::Locked, QueueMode::LockFree}) {
+            QueueConfig config;
+            config.mode = mode;
+            dispatcher.configure_queue(config);
+
+            std::string name = std::string("queue/") + (mode == QueueMode::Locked ? "locked/" : "lock_free/") +
+                               std::to_string(producers) + "_producers";
+            run(name, 1000000, [&](size_t n) {
+                size_t per_producer = std::max<size_t>(1, n / producers);
+                std::atomic<size_t> done{0};
+                std::vector<std::thread> threads;
+                for (size_t p = 0; p < producers; ++p) {
+                    threads.emplace_back([&] {
+                        for (size_t i = 0; i < per_producer; ++i) {
+                            dispatcher.queue_event(std::make_unique<MouseEvent>(MouseEvent::Action::Move, 1.0, 2.0));
+                        }
+                        done.fetch_add(1, std::memory_order_release);
+                    });
+                }
+                // The calling thread is the single consumer
+                while (done.load(std::memory_order_acquire) < producers || dispatcher.pending_events() > 0) {
+                    dispatcher.process_queue();
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            });
+        }
+    }
+    dispatcher.configure_queue(QueueConfig());
+    sink += calls;
+}
+
+void bench_wrappers() {
+    uint64_t calls = 0;
+    MouseEvent event(MouseEvent::Action::Move, 1.0, 2.0);
+
+    {
+        EventDispatcher dispatcher;
+        dispatcher.subscribe("mouse", [&calls](Event&) { ++calls; });
+        run("wrapper/raw_lambda", 2000000, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) dispatcher.dispatch(event);
+        });
+    }
+    {
+        EventDispatcher dispatcher;
+        dispatcher.subscribe("mouse", TypedEventHandler<MouseEvent>([&calls](MouseEvent&) { ++calls; }));
+        run("wrapper/typed_event_handler", 2000000, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) dispatcher.dispatch(event);
+        });
+    }
+    {
+        EventDispatcher dispatcher;
+        auto handler = std::make_shared<AutoEventHandler<MouseEvent>>("mouse", [&calls](MouseEvent&) { ++calls; });
+        dispatcher.subscribe("mouse", [handler](Event& e) { handler->handle(e); });
+        run("wrapper/auto_event_handler", 2000000, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) dispatcher.dispatch(event);
+        });
+    }
+    sink += calls;
+}
+
+void bench_data() {
+    MouseEvent event(MouseEvent::Action::Move, 1.0, 2.0);
+    const AttributeKey key = attribute_key_registry().intern("bench.value");
+
+    run("data/set_data_string_key", 2000000, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) event.set_data("bench.value", static_cast<int>(i));
+    });
+    run("data/set_data_attribute_key", 2000000, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) event.set_data(key, static_cast<int>(i));
+    });
+    run("data/get_data_as_string_key", 2000000, [&](size_t n) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < n; ++i) total += event.get_data_as<int>("bench.value");
+        sink += total;
+    });
+    run("data/get_data_as_attribute_key", 2000000, [&](size_t n) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < n; ++i) total += event.get_data_as<int>(key);
+        sink += total;
+    });
+    run("data/set_data_std_string", 1000000, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) event.set_data(key, std::string("a moderately long payload string"));
+    });
+}
+
+void bench_allocation() {
+    run("event/make_unique_mouse", 2000000, [](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            auto event = std::make_unique<MouseEvent>(MouseEvent::Action::Move, 1.0, 2.0);
+            sink += event->type_id();
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) filter = argv[1];
+    if (argc > 2) scale = std::max(0.001, std::atof(argv[2]));
+
+    std::cout << "events benchmark (filter: " << (filter.empty() ? "none" : filter)
+              << ", scale: " << scale << ")\n";
+
+    bench_subscribe();
+    bench_dispatch();
+    bench_queue();
+    bench_wrappers();
+    bench_data();
+    bench_allocation();
+
+    return sink.load() == 0xdeadbeef ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "events/event.hpp"
+#include "events/dispatcher.hpp"
+#include "events/shm_channel.hpp"
+
+// Usage: shm_channel_benchmark [events] [ring-capacity]
+//
+// Forks a consumer process and streams mouse events to it through a
+// shared-memory channel. Each event carries its send time in x, so the
+// consumer reports the cross-process latency; a "done" custom event ends
+// the run. Exits non-zero if the consumer did not see every event.
+
+namespace {
+
+using namespace temp2::events;
+using Clock = std::chrono::steady_clock;
+
+const std::string CHANNEL = "/temp2_shm_channel_benchmark";
+
+// steady_clock is CLOCK_MONOTONIC on Linux, shared by both processes
+double now_ns() {
+    return std::chrono::duration<double, std::nano>(Clock::now().time_since_epoch()).count();
+}
+
+void print(const std::string& name, double value, const char* unit) {
+    std::cout << std::left << std::setw(40) << name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << value << " " << unit << "\n";
+}
+
+// =============================================================================
+// Consumer process
+// =============================================================================
+
+int run_consumer(size_t expected) {
+    ShmEventConsumer consumer(CHANNEL);
+    EventDispatcher dispatcher;
+
+    size_t received = 0;
+    double total_latency = 0.0;
+    double max_latency = 0.0;
+    bool done = false;
+    dispatcher.subscribe("mouse", [&](Event& event) {
+        double latency = now_ns() - static_cast<MouseEvent&>(event).x();
+        total_latency += latency;
+        max_latency = std::max(max_latency, latency);
+        ++received;
+    });
+    dispatcher.subscribe("custom", [&](Event& event) {
+        done = static_cast<CustomEvent&>(event).name() == "done";
+    });
+
+    while (!done) {
+        if (consumer.poll(dispatcher) == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    print("consumer/mean_latency", received ? total_latency / static_cast<double>(received) : 0.0, "ns");
+    print("consumer/max_latency", max_latency, "ns");
+    if (received != expected || consumer.skipped() != 0) {
+        std::cerr << "consumer received " << received << " of " << expected << " events, skipped "
+                  << consumer.skipped() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// =============================================================================
+// Producer process
+// =============================================================================
+
+// Retries until the consumer frees a slot; drops are not part of this test
+void post_blocking(ShmEventProducer& producer, const Event& event, size_t& retries) {
+    while (!producer.post(event)) {
+        ++retries;
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t events = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : ShmEventProducer::DEFAULT_CAPACITY;
+
+    std::cout << "shm channel benchmark (events: " << events << ", capacity: " << capacity << ")\n";
+
+    // The segment exists before the fork, so the child can open it right away
+    ShmEventProducer producer(CHANNEL, capacity);
+
+    std::cout.flush();  // Or the child would print the buffered header again
+    pid_t child = ::fork();
+    if (child < 0) {
+        std::cerr << "fork failed\n";
+        return 1;
+    }
+    if (child == 0) {
+        int status = 1;
+        try {
+            status = run_consumer(events);
+        } catch (const std::exception& error) {
+            std::cerr << "consumer: " << error.what() << "\n";
+        }
+        std::cout.flush();
+        ::_exit(status);  // The producer object belongs to the parent
+    }
+
+    size_t retries = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < events; ++i) {
+        MouseEvent event(MouseEvent::Action::Move, now_ns(), static_cast<double>(i));
+        post_blocking(producer, event, retries);
+    }
+    post_blocking(producer, CustomEvent("done"), retries);
+
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    print("producer/events_per_second", static_cast<double>(events) / ns * 1e9, "ev/s");
+    print("producer/ns_per_event", ns / static_cast<double>(std::max<size_t>(events, 1)), "ns");
+    print("producer/full_ring_retries", static_cast<double>(retries), "");
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1;
+}
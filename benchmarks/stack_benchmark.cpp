@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "containers/stack.hpp"
+
+// Usage: stack_benchmark [name-filter] [iteration-scale]
+
+namespace {
+
+using namespace temp2::containers;
+using Clock = std::chrono::steady_clock;
+
+// =============================================================================
+// Harness
+// =============================================================================
+
+std::string filter;
+double scale = 1.0;
+std::atomic<uint64_t> sink{0};
+
+size_t scaled(size_t iterations) {
+    return std::max<size_t>(1, static_cast<size_t>(static_cast<double>(iterations) * scale));
+}
+
+// Runs body(thread, iterations) on `threads` threads started together; each
+// thread performs `iterations` ops, and the warm-up run uses a tenth of that
+template <typename Body>
+void run(const std::string& name, size_t threads, size_t iterations, Body&& body) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+    iterations = scaled(iterations);
+    auto measure = [&](size_t per_thread) {
+        std::atomic<size_t> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                ready.fetch_add(1, std::memory_order_relaxed);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                body(t, per_thread);
+            });
+        }
+        while (ready.load(std::memory_order_relaxed) < threads) {
+            std::this_thread::yield();
+        }
+        auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return Clock::now() - start;
+    };
+
+    measure(std::max<size_t>(1, iterations / 10));
+    auto elapsed = measure(iterations);
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    double ops = static_cast<double>(iterations * threads);
+    std::cout << std::left << std::setw(52) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1) << ns / ops << " ns/op"
+              << std::setw(12) << std::setprecision(2) << ops / ns * 1000.0 << " Mops/s\n";
+}
+
+// =============================================================================
+// Contenders
+// =============================================================================
+
+// The shared free-list setup ConcurrentStack replaces
+class LockedStack {
+public:
+    void push(int value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stack_.push(value);
+    }
+
+    std::optional<int> try_pop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stack_.try_pop();
+    }
+
+    void push_range(const std::vector<int>& values) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int value : values) {
+            stack_.push(value);
+        }
+    }
+
+    std::vector<int> pop_all() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<int> values;
+        values.reserve(stack_.size());
+        while (auto value = stack_.try_pop()) {
+            values.push_back(*value);
+        }
+        return values;
+    }
+
+private:
+    std::mutex mutex_;
+    LinkedStack<int> stack_;
+};
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+
+constexpr size_t BATCH = 64;
+
+template <typename Stack>
+void bench_stack(const std::string& label, size_t threads) {
+    std::string suffix = std::string("/") + std::to_string(threads) + "_threads";
+
+    {
+        Stack stack;
+        run(label + "/push_pop" + suffix, threads, 1000000, [&](size_t t, size_t n) {
+            uint64_t total = 0;
+            for (size_t i = 0; i < n; ++i) {
+                stack.push(static_cast<int>(t + i));
+                if (auto value = stack.try_pop()) {
+                    total += static_cast<uint64_t>(*value);
+                }
+            }
+            sink += total;
+        });
+    }
+
+    {
+        Stack stack;
+        run(label + "/push_range_pop_all" + suffix, threads, 1000000, [&](size_t t, size_t n) {
+            std::vector<int> batch(BATCH, static_cast<int>(t));
+            uint64_t total = 0;
+            for (size_t i = 0; i < n; i += BATCH) {
+                stack.push_range(batch);
+                total += stack.pop_all().size();
+            }
+            sink += total;
+        });
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) filter = argv[1];
+    if (argc > 2) scale = std::max(0.001, std::atof(argv[2]));
+
+    std::cout << "stack benchmark (filter: " << (filter.empty() ? "none" : filter)
+              << ", scale: " << scale << ")\n";
+
+    size_t max_threads = std::max<size_t>(2, std::thread::hardware_concurrency());
+    // Powers of two, always ending with the machine's own thread count
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    for (size_t threads : thread_counts) {
+        bench_stack<LockedStack>("mutex_linked_stack", threads);
+        bench_stack<ConcurrentStack<int>>("concurrent_stack", threads);
+    }
+
+    return sink.load() == 0xdeadbeef ? 1 : 0;
+}
@@ -1,9 +1,16 @@
 #ifndef TEMP2_CONTAINERS_LINKED_LIST_HPP
 #define TEMP2_CONTAINERS_LINKED_LIST_HPP
 
+#include "node_pool.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace temp2::containers {
@@ -21,10 +28,74 @@ struct SListNode {
 
 /**
  * @brief Singly linked list implementation
+ *
+ * Nodes come from Allocator rebound to SListNode<T>. The default pool
+ * recycles freed nodes, and reserve(n) pre-populates it so that up to n
+ * elements can be held without touching the system allocator.
+ *
+ * Iterators carry their predecessor as a hint, so insert_after(), erase()
+ * and splice() are O(1) while it holds; an insertion in front of the
+ * iterator's element (push_front() before begin(), say) costs one walk from
+ * the head instead. end() is a plain sentinel and stays valid across
+ * appends. Removing an element invalidates iterators to it and to the
+ * element after it, whose hint it was. The list remembers the last
+ * position reached through at(), insert_at() or remove_at() and walks on
+ * from there, so ascending index loops are amortized O(1) per step.
+ * Splicing between two pooled lists merges their pools; the lists then
+ * share it and must not be modified concurrently. sort() is a stable
+ * bottom-up merge sort that relinks nodes and never copies, moves or
+ * allocates elements.
  */
-template <typename T>
+template <typename T, typename Allocator = NodePoolAllocator<T>>
 class SinglyLinkedList {
 public:
+    template <bool Const>
+    class BasicIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        BasicIterator() = default;
+
+        // iterator converts to const_iterator
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        BasicIterator(const BasicIterator<OtherConst>& other) : prev_(other.prev_), node_(other.node_) {}
+
+        reference operator*() const { return node_->data; }
+        pointer operator->() const { return &node_->data; }
+
+        BasicIterator& operator++() {
+            prev_ = node_;
+            node_ = node_->next;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) { return a.node_ == b.node_; }
+
+    private:
+        friend class SinglyLinkedList;
+        template <bool>
+        friend class BasicIterator;
+
+        BasicIterator(SListNode<T>* prev, SListNode<T>* node) : prev_(prev), node_(node) {}
+
+        SListNode<T>* prev_ = nullptr;
+        SListNode<T>* node_ = nullptr;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
     SinglyLinkedList();
     ~SinglyLinkedList();
 
@@ -43,6 +114,13 @@ public:
     void remove_at(size_t index);
     void remove_value(const T& value);
     void clear();
+    void reserve(size_t count);
+
+    // Iterator-based modifiers
+    iterator insert_after(const_iterator pos, const T& value);
+    iterator erase(const_iterator pos);
+    void splice(const_iterator pos, SinglyLinkedList& other);
+    void splice(const_iterator pos, SinglyLinkedList& other, const_iterator it);
 
     // Access
     T& front();
@@ -62,16 +140,43 @@ public:
     // Operations
     void reverse();
     void sort();
+    void sort(const std::function<bool(const T&, const T&)>& less);
     std::vector<T> to_vector() const;
     void for_each(const std::function<void(T&)>& fn);
     void for_each(const std::function<void(const T&)>& fn) const;
 
+    // Iteration
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
 private:
-    SListNode<T>* head_;
-    SListNode<T>* tail_;
+    using Node = SListNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    Node* head_;
+    Node* tail_;
     size_t size_;
+    NodeAllocator alloc_;
+
+    // Last position reached by index; only non-const calls move it
+    Node* cursor_node_;
+    size_t cursor_index_;
 
     void copy_from(const SinglyLinkedList& other);
+    Node* create_node(const T& value);
+    void destroy_node(Node* node);
+    Node* seek(size_t index) const;
+    void reset_cursor();
+    // Node before pos (nullptr at the head); the iterator's cached one when still valid
+    Node* predecessor(const_iterator pos) const;
+    void share_allocator(SinglyLinkedList& other);
+    template <typename Compare>
+    void merge_sort(const Compare& less);
 };
 
 /**
@@ -88,10 +193,73 @@ struct DListNode {
 
 /**
  * @brief Doubly linked list implementation
+ *
+ * Node allocation, reserve(), splice(), sort() and the index cursor work
+ * as in SinglyLinkedList; index lookups start from whichever of head, tail and
+ * cursor is closest. Iterators are bidirectional and only invalidated by
+ * erasing or splicing away their own element.
  */
-template <typename T>
+template <typename T, typename Allocator = NodePoolAllocator<T>>
 class DoublyLinkedList {
 public:
+    template <bool Const>
+    class BasicIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        BasicIterator() = default;
+
+        // iterator converts to const_iterator
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        BasicIterator(const BasicIterator<OtherConst>& other) : node_(other.node_), list_(other.list_) {}
+
+        reference operator*() const { return node_->data; }
+        pointer operator->() const { return &node_->data; }
+
+        BasicIterator& operator++() {
+            node_ = node_->next;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        // Stepping back from end() lands on the tail
+        BasicIterator& operator--() {
+            node_ = node_ ? node_->prev : list_->tail_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator copy = *this;
+            --*this;
+            return copy;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) { return a.node_ == b.node_; }
+
+    private:
+        friend class DoublyLinkedList;
+        template <bool>
+        friend class BasicIterator;
+
+        BasicIterator(DListNode<T>* node, const DoublyLinkedList* list) : node_(node), list_(list) {}
+
+        DListNode<T>* node_ = nullptr;
+        const DoublyLinkedList* list_ = nullptr;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
     DoublyLinkedList();
     ~DoublyLinkedList();
 
@@ -109,6 +277,13 @@ public:
     void pop_back();
     void remove_at(size_t index);
     void clear();
+    void reserve(size_t count);
+
+    // Iterator-based modifiers
+    iterator insert_after(const_iterator pos, const T& value);
+    iterator erase(const_iterator pos);
+    void splice(const_iterator pos, DoublyLinkedList& other);
+    void splice(const_iterator pos, DoublyLinkedList& other, const_iterator it);
 
     // Access
     T& front();
@@ -124,19 +299,145 @@ public:
 
     // Operations
     void reverse();
+    void sort();
+    void sort(const std::function<bool(const T&, const T&)>& less);
     std::vector<T> to_vector() const;
     std::vector<T> to_vector_reverse() const;
 
     // Iteration
     void for_each_forward(const std::function<void(T&)>& fn);
     void for_each_backward(const std::function<void(T&)>& fn);
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
 
 private:
-    DListNode<T>* head_;
-    DListNode<T>* tail_;
+    using Node = DListNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    Node* head_;
+    Node* tail_;
     size_t size_;
+    NodeAllocator alloc_;
+
+    Node* cursor_node_;
+    size_t cursor_index_;
 
     void copy_from(const DoublyLinkedList& other);
+    Node* create_node(const T& value);
+    void destroy_node(Node* node);
+    Node* seek(size_t index) const;
+    void reset_cursor();
+    void share_allocator(DoublyLinkedList& other);
+    void link_before(Node* pos, Node* first, Node* last);
+    template <typename Compare>
+    void merge_sort(const Compare& less);
+};
+
+/**
+ * @brief Unrolled linked list node holding up to CAPACITY elements
+ *
+ * Sized to about four cache lines; elements live in raw storage and only
+ * the first `count` slots are constructed.
+ */
+template <typename T>
+struct alignas(NodePool<T>::CACHE_LINE) UListNode {
+    static constexpr size_t TARGET_BYTES = 4 * NodePool<T>::CACHE_LINE;
+    static constexpr size_t CAPACITY = std::max<size_t>(4, (TARGET_BYTES - 2 * sizeof(void*)) / sizeof(T));
+
+    UListNode* next;
+    size_t count;
+    alignas(T) unsigned char storage[CAPACITY * sizeof(T)];
+
+    UListNode() : next(nullptr), count(0) {}
+
+    T* items() { return std::launder(reinterpret_cast<T*>(storage)); }
+    const T* items() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+};
+
+/**
+ * @brief Singly linked list storing several elements per node
+ *
+ * Same interface as SinglyLinkedList, but traversal walks contiguous
+ * arrays and touches one node per CAPACITY elements. Middle inserts shift
+ * within a node and split it when full; removals merge a node into its
+ * successor once both fit in one.
+ */
+template <typename T, typename Allocator = NodePoolAllocator<T>>
+class UnrolledLinkedList {
+public:
+    static constexpr size_t NODE_CAPACITY = UListNode<T>::CAPACITY;
+
+    UnrolledLinkedList();
+    ~UnrolledLinkedList();
+
+    // Copy and move
+    UnrolledLinkedList(const UnrolledLinkedList& other);
+    UnrolledLinkedList(UnrolledLinkedList&& other) noexcept;
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& other);
+    UnrolledLinkedList& operator=(UnrolledLinkedList&& other) noexcept;
+
+    // Modifiers
+    void push_front(const T& value);
+    void push_back(const T& value);
+    void insert_at(size_t index, const T& value);
+    void pop_front();
+    void pop_back();
+    void remove_at(size_t index);
+    void remove_value(const T& value);
+    void clear();
+    void reserve(size_t count);
+
+    // Access
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+    T& at(size_t index);
+    const T& at(size_t index) const;
+    std::optional<T> find(const T& value) const;
+
+    // Properties
+    size_t size() const;
+    bool empty() const;
+    bool contains(const T& value) const;
+    size_t count(const T& value) const;
+
+    // Operations
+    void reverse();
+    void sort();
+    void sort(const std::function<bool(const T&, const T&)>& less);
+    std::vector<T> to_vector() const;
+    void for_each(const std::function<void(T&)>& fn);
+    void for_each(const std::function<void(const T&)>& fn) const;
+
+private:
+    using Node = UListNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    Node* head_;
+    Node* tail_;
+    size_t size_;
+    NodeAllocator alloc_;
+
+    void copy_from(const UnrolledLinkedList& other);
+    Node* create_node();
+    void destroy_node(Node* node);
+
+    // Node holding element `index`; `index` becomes the offset inside it
+    Node* locate(size_t& index) const;
+    // Move elements forward so that every node but the tail is full
+    void pack();
+    template <typename Compare>
+    void sort_values(const Compare& less);
+    void insert_into(Node* node, size_t offset, T&& value);
+    void erase_from(Node* prev, Node* node, size_t offset);
+    void unlink(Node* prev, Node* node);
 };
 
 }  // namespace temp2::containers
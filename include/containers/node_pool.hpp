@@ -0,0 +1,240 @@
+#ifndef TEMP2_CONTAINERS_NODE_POOL_HPP
+#define TEMP2_CONTAINERS_NODE_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace temp2::containers {
+
+/**
+ * @brief Free-list pool of fixed-size slots for node-based containers
+ *
+ * Slots are carved out of cache-line-aligned chunks whose size doubles up
+ * to MAX_CHUNK_SLOTS. Released slots go onto an intrusive free list and are
+ * handed out again before any new chunk is requested; chunks are only
+ * returned to the system when the pool is destroyed. Not thread-safe.
+ */
+template <typename T>
+class NodePool {
+public:
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t MIN_CHUNK_SLOTS = 16;
+    static constexpr size_t MAX_CHUNK_SLOTS = 4096;
+
+    NodePool()
+        : free_(nullptr), free_tail_(nullptr), free_count_(0), capacity_(0), next_chunk_slots_(MIN_CHUNK_SLOTS) {}
+
+    ~NodePool() {
+        for (void* chunk : chunks_) {
+            ::operator delete(chunk, std::align_val_t{CHUNK_ALIGN});
+        }
+    }
+
+    // Delete copy
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    T* allocate() {
+        if (!free_) {
+            grow(next_chunk_slots_);
+        }
+        Slot* slot = free_;
+        free_ = slot->next;
+        if (!free_) {
+            free_tail_ = nullptr;
+        }
+        --free_count_;
+        return reinterpret_cast<T*>(slot->storage);
+    }
+
+    void deallocate(T* ptr) noexcept {
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        slot->next = free_;
+        if (!free_) {
+            free_tail_ = slot;
+        }
+        free_ = slot;
+        ++free_count_;
+    }
+
+    // Make sure at least `count` slots can be allocated without growing
+    void reserve(size_t count) {
+        if (free_count_ < count) {
+            grow(count - free_count_);
+        }
+    }
+
+    // Take over all chunks and free slots of other, leaving it empty
+    void merge(NodePool& other) {
+        chunks_.reserve(chunks_.size() + other.chunks_.size());
+        chunks_.insert(chunks_.end(), other.chunks_.begin(), other.chunks_.end());
+        other.chunks_.clear();
+
+        if (other.free_) {
+            if (free_) {
+                free_tail_->next = other.free_;
+            } else {
+                free_ = other.free_;
+            }
+            free_tail_ = other.free_tail_;
+        }
+        free_count_ += other.free_count_;
+        capacity_ += other.capacity_;
+        next_chunk_slots_ = std::max(next_chunk_slots_, other.next_chunk_slots_);
+
+        other.free_ = nullptr;
+        other.free_tail_ = nullptr;
+        other.free_count_ = 0;
+        other.capacity_ = 0;
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t available() const { return free_count_; }
+
+    // Pool that took over this one's chunks in a merge, if any. Allocators
+    // still holding this pool forward to it, and holding it keeps it alive
+    const std::shared_ptr<NodePool>& successor() const { return successor_; }
+    void set_successor(std::shared_ptr<NodePool> pool) { successor_ = std::move(pool); }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t CHUNK_ALIGN = std::max(CACHE_LINE, alignof(Slot));
+
+    void grow(size_t slots) {
+        slots = std::max(slots, next_chunk_slots_);
+        size_t bytes = (slots * sizeof(Slot) + CHUNK_ALIGN - 1) / CHUNK_ALIGN * CHUNK_ALIGN;
+        slots = bytes / sizeof(Slot);
+
+        chunks_.reserve(chunks_.size() + 1);
+        auto* chunk = static_cast<Slot*>(::operator new(bytes, std::align_val_t{CHUNK_ALIGN}));
+        chunks_.push_back(chunk);
+
+        // Thread back to front so slots are handed out in address order
+        if (!free_) {
+            free_tail_ = &chunk[slots - 1];
+        }
+        for (size_t i = slots; i > 0; --i) {
+            chunk[i - 1].next = free_;
+            free_ = &chunk[i - 1];
+        }
+        free_count_ += slots;
+        capacity_ += slots;
+        next_chunk_slots_ = std::min(next_chunk_slots_ * 2, MAX_CHUNK_SLOTS);
+    }
+
+    Slot* free_;
+    Slot* free_tail_;
+    size_t free_count_;
+    size_t capacity_;
+    size_t next_chunk_slots_;
+    std::vector<void*> chunks_;
+    std::shared_ptr<NodePool> successor_;
+};
+
+/**
+ * @brief Allocator serving single-object requests from a NodePool
+ *
+ * Intended as the node allocator of the linked containers: copies share the
+ * pool, but a container copy (select_on_container_copy_construction) and a
+ * rebind to another type start a pool of their own, so every container owns
+ * its nodes' memory. The pool is created on first allocation, which keeps
+ * empty and moved-from containers free of heap memory. Array requests bypass
+ * the pool. merge() lets two containers exchange nodes by making them share
+ * one pool. The absorbed pool hands its chunks over and forwards to the
+ * surviving one, so a third container that still holds it follows along.
+ */
+template <typename T>
+class NodePoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    NodePoolAllocator() noexcept = default;
+
+    // Different slot size, so a separate pool
+    template <typename U>
+    NodePoolAllocator(const NodePoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n != 1) {
+            return std::allocator<T>().allocate(n);
+        }
+        return pool().allocate();
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (n != 1) {
+            std::allocator<T>().deallocate(ptr, n);
+            return;
+        }
+        follow().deallocate(ptr);
+    }
+
+    NodePoolAllocator select_on_container_copy_construction() const {
+        return NodePoolAllocator();
+    }
+
+    void reserve(size_t count) {
+        pool().reserve(count);
+    }
+
+    // Fold other's pool into this one; afterwards both allocators share it
+    void merge(NodePoolAllocator& other) {
+        NodePool<T>& shared = pool();
+        if (other.pool_) {
+            NodePool<T>& absorbed = other.pool();
+            if (&absorbed == &shared) return;
+            shared.merge(absorbed);
+            absorbed.set_successor(pool_);
+        }
+        other.pool_ = pool_;
+    }
+
+    size_t capacity() const { return pool_ ? current(pool_)->capacity() : 0; }
+    size_t available() const { return pool_ ? current(pool_)->available() : 0; }
+
+    friend bool operator==(const NodePoolAllocator& a, const NodePoolAllocator& b) noexcept {
+        return current(a.pool_) == current(b.pool_);
+    }
+
+private:
+    static NodePool<T>* current(const std::shared_ptr<NodePool<T>>& pool) noexcept {
+        NodePool<T>* result = pool.get();
+        while (result && result->successor()) {
+            result = result->successor().get();
+        }
+        return result;
+    }
+
+    NodePool<T>& pool() {
+        if (!pool_) {
+            pool_ = std::make_shared<NodePool<T>>();
+        }
+        return follow();
+    }
+
+    // Skip pools merged away since the last call; pool_ must be set
+    NodePool<T>& follow() noexcept {
+        while (pool_->successor()) {
+            pool_ = pool_->successor();
+        }
+        return *pool_;
+    }
+
+    std::shared_ptr<NodePool<T>> pool_;
+};
+
+}  // namespace temp2::containers
+
+#endif  // TEMP2_CONTAINERS_NODE_POOL_HPP
@@ -1,7 +1,12 @@
 #ifndef TEMP2_CONTAINERS_STACK_HPP
 #define TEMP2_CONTAINERS_STACK_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -74,6 +79,74 @@ private:
     void copy_from(const LinkedStack& other);
 };
 
+/**
+ * @brief Lock-free multi-producer multi-consumer stack (Treiber stack)
+ *
+ * Nodes are carved out of chunks owned by the stack and recycled through an
+ * internal lock-free free list; they are only returned to the system when
+ * the stack is destroyed. A popping thread may therefore still read a node
+ * that was recycled under it, and the head word packs a 32-bit node index
+ * with a 32-bit tag bumped by every successful CAS, so such a stale CAS
+ * fails instead of corrupting the stack (ABA). The tag wraps after 2^32
+ * successful CASes on one head, so a popper preempted between loading the
+ * head and its CAS for that long could still succeed on a recycled node;
+ * the protection is probabilistic, not absolute. The head is a plain 64-bit
+ * atomic, which is lock-free on all supported targets.
+ *
+ * push_range() links its nodes privately and publishes them with one CAS;
+ * pop_all() detaches the whole stack with one CAS. size() is approximate
+ * while other threads are pushing or popping.
+ */
+template <typename T>
+class ConcurrentStack {
+public:
+    static constexpr size_t FIRST_CHUNK_NODES = 64;
+    static constexpr size_t MAX_CHUNKS = 26;  // Chunks double, so 64 * (2^26 - 1) nodes fit 32-bit indices
+
+    ConcurrentStack();
+    ~ConcurrentStack();
+
+    // Delete copy
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    void push(const T& value);
+    void push(T&& value);
+    void push_range(std::span<const T> values);
+    T pop();
+    std::optional<T> try_pop();
+    std::vector<T> pop_all();  // Top first
+
+    size_t size() const;
+    bool empty() const;
+    void clear();
+    void reserve(size_t count);
+
+private:
+    struct Node {
+        std::atomic<uint32_t> next{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    Node& node(uint32_t index) const;
+    uint32_t acquire_node();
+    Node* chunk(size_t index);
+    uint32_t pop_index(std::atomic<uint64_t>& head);
+    void push_chain(std::atomic<uint64_t>& head, uint32_t first, uint32_t last);
+    template <typename U>
+    void push_value(U&& value);
+
+    alignas(CACHE_LINE) std::atomic<uint64_t> head_;
+    alignas(CACHE_LINE) std::atomic<uint64_t> free_;
+    alignas(CACHE_LINE) std::atomic<size_t> size_;
+    std::atomic<size_t> next_slot_;
+    std::atomic<Node*> chunks_[MAX_CHUNKS];
+};
+
 /**
  * @brief Min-stack that tracks minimum element
  */
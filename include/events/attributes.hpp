@@ -0,0 +1,124 @@
+#ifndef TEMP2_EVENTS_ATTRIBUTES_HPP
+#define TEMP2_EVENTS_ATTRIBUTES_HPP
+
+#include "registry.hpp"
+#include <any>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace temp2::events {
+
+using AttributeKey = NameRegistry::Id;
+
+/**
+ * @brief Process-wide registry of event attribute key names
+ */
+NameRegistry& attribute_key_registry();
+
+/**
+ * @brief Tagged value for an event attribute
+ *
+ * Common scalar types and strings are stored inline; anything else falls
+ * back to std::any. Values keep their exact type, so as<T>() only succeeds
+ * for the type that was stored, matching std::any_cast.
+ */
+class AttributeValue {
+public:
+    using Storage = std::variant<std::monostate, bool, int, int64_t, double, std::string, std::any>;
+
+    AttributeValue() = default;
+
+    template <typename T>
+    static AttributeValue from(T&& value) {
+        using U = std::decay_t<T>;
+        AttributeValue result;
+        if constexpr (is_inline<U>()) {
+            result.storage_ = U(std::forward<T>(value));
+        } else {
+            result.storage_ = std::any(std::forward<T>(value));
+        }
+        return result;
+    }
+
+    static AttributeValue from_any(const std::any& value);
+
+    template <typename T>
+    T as() const {
+        using U = std::remove_cv_t<std::remove_reference_t<T>>;
+        if constexpr (is_inline<U>()) {
+            if (const U* inline_value = std::get_if<U>(&storage_)) {
+                return *inline_value;
+            }
+            throw std::bad_any_cast();
+        } else {
+            if (const std::any* boxed = std::get_if<std::any>(&storage_)) {
+                return std::any_cast<T>(*boxed);
+            }
+            throw std::bad_any_cast();
+        }
+    }
+
+    std::any to_any() const;
+    bool empty() const;
+    const Storage& storage() const;
+
+private:
+    template <typename U>
+    static constexpr bool is_inline() {
+        return std::is_same_v<U, bool> || std::is_same_v<U, int> || std::is_same_v<U, int64_t> ||
+               std::is_same_v<U, double> || std::is_same_v<U, std::string>;
+    }
+
+    Storage storage_;
+};
+
+/**
+ * @brief Flat attribute map keyed by interned AttributeKey
+ *
+ * The first INLINE_CAPACITY attributes live inside the store itself, so
+ * events with a handful of scalar fields never touch the heap; further
+ * attributes spill into a vector. Lookups are a linear scan of key IDs.
+ */
+class AttributeStore {
+public:
+    static constexpr size_t INLINE_CAPACITY = 4;
+
+    AttributeStore();
+
+    void set(AttributeKey key, AttributeValue value);
+    const AttributeValue* find(AttributeKey key) const;
+    bool contains(AttributeKey key) const;
+    size_t size() const;
+    bool empty() const;
+    void clear();
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t i = 0; i < inline_size_; ++i) {
+            fn(inline_[i].key, inline_[i].value);
+        }
+        for (const auto& entry : overflow_) {
+            fn(entry.key, entry.value);
+        }
+    }
+
+private:
+    struct Entry {
+        AttributeKey key = 0;
+        AttributeValue value;
+    };
+
+    AttributeValue* find_mutable(AttributeKey key);
+
+    std::array<Entry, INLINE_CAPACITY> inline_;
+    size_t inline_size_;
+    std::vector<Entry> overflow_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_ATTRIBUTES_HPP
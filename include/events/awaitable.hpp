@@ -0,0 +1,180 @@
+#ifndef TEMP2_EVENTS_AWAITABLE_HPP
+#define TEMP2_EVENTS_AWAITABLE_HPP
+
+#include "event.hpp"
+#include "registry.hpp"
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace temp2::events {
+
+class EventDispatcher;
+
+/**
+ * @brief Event types whose type ID is known without an instance
+ */
+template <typename EventType>
+concept StaticallyTypedEvent = std::derived_from<EventType, Event> && requires {
+    { EventType::static_type_id() } -> std::convertible_to<EventTypeId>;
+};
+
+/**
+ * @brief Filter accepting every event
+ */
+struct AcceptAnyEvent {
+    bool operator()(const Event&) const { return true; }
+};
+
+// Link of the intrusive per-type waiter lists; list heads are bare links
+struct WaiterLink {
+    WaiterLink* prev = this;
+    WaiterLink* next = this;
+};
+
+/**
+ * @brief Registration of one suspended coroutine with a dispatcher
+ *
+ * The waiter lives inside the awaiting coroutine's frame and is linked into
+ * the dispatcher's list for its event type, so waiting allocates nothing.
+ * Destroying a waiting coroutine unlinks it and cancels the wait.
+ */
+class EventWaiter : private WaiterLink {
+public:
+    // Delete copy
+    EventWaiter(const EventWaiter&) = delete;
+    EventWaiter& operator=(const EventWaiter&) = delete;
+
+protected:
+    using MatchFunc = bool (*)(EventWaiter& waiter, Event& event);
+
+    EventWaiter(EventDispatcher& dispatcher, EventTypeId type_id, MatchFunc matches);
+    ~EventWaiter();
+
+    void suspend(std::coroutine_handle<> handle);
+    Event& event() const { return *event_; }
+
+private:
+    friend class EventDispatcher;
+
+    enum class State { Idle, Waiting, Firing, Fired };
+
+    EventDispatcher* dispatcher_;  // Null once the dispatcher is destroyed
+    EventTypeId type_id_;
+    MatchFunc matches_;
+    std::coroutine_handle<> handle_;
+    Event* event_;
+    State state_;
+};
+
+/**
+ * @brief Awaitable returned by EventDispatcher::next
+ *
+ * co_await suspends until an event of the type passing the filter is
+ * dispatched and evaluates to that event. The reference is valid until the
+ * coroutine next suspends. The filter is stored by value and must not call
+ * back into the dispatcher.
+ */
+template <typename EventType, typename Filter>
+class NextEvent : private EventWaiter {
+public:
+    NextEvent(EventDispatcher& dispatcher, EventTypeId type_id, Filter filter)
+        : EventWaiter(dispatcher, type_id, &NextEvent::matches), filter_(std::move(filter)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { suspend(handle); }
+    EventType& await_resume() const { return static_cast<EventType&>(event()); }
+
+private:
+    static bool matches(EventWaiter& waiter, Event& event) {
+        auto& self = static_cast<NextEvent&>(waiter);
+        return self.filter_(static_cast<const EventType&>(event));
+    }
+
+    Filter filter_;
+};
+
+/**
+ * @brief Coroutine type for event-driven flows
+ *
+ * The coroutine starts running immediately and resumes on whichever thread
+ * dispatches the event it waits for. Destroying the task destroys a flow
+ * that is still waiting; detach() lets it run to completion on its own. An
+ * exception escaping the flow is kept for rethrow_if_failed, or terminates
+ * the program if the task was detached. A detached flow still waiting when
+ * its dispatcher is destroyed is never resumed, so its frame is not freed.
+ */
+class EventTask {
+public:
+    struct promise_type {
+        std::exception_ptr error;
+        bool detached = false;
+
+        EventTask get_return_object() {
+            return EventTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept {
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+                    if (handle.promise().detached) handle.destroy();
+                }
+                void await_resume() const noexcept {}
+            };
+            return FinalAwaiter{};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() {
+            if (detached) std::terminate();
+            error = std::current_exception();
+        }
+    };
+
+    EventTask() = default;
+    EventTask(EventTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    EventTask& operator=(EventTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~EventTask() { reset(); }
+
+    bool valid() const { return static_cast<bool>(handle_); }
+    bool done() const { return handle_ && handle_.done(); }
+
+    void detach() {
+        if (!handle_) return;
+        if (handle_.done()) {
+            handle_.destroy();
+        } else {
+            handle_.promise().detached = true;
+        }
+        handle_ = nullptr;
+    }
+
+    void rethrow_if_failed() const {
+        if (handle_ && handle_.promise().error) {
+            std::rethrow_exception(handle_.promise().error);
+        }
+    }
+
+private:
+    explicit EventTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_AWAITABLE_HPP
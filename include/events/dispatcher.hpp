@@ -1,57 +1,410 @@
 #ifndef TEMP2_EVENTS_DISPATCHER_HPP
 #define TEMP2_EVENTS_DISPATCHER_HPP
 
+#include "awaitable.hpp"
 #include "event.hpp"
+#include "event_queue.hpp"
+#include "metrics.hpp"
+#include "rcu_pointer.hpp"
+#include "timer_wheel.hpp"
+#include "worker_pool.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <map>
 #include <vector>
 #include <memory>
-#include <queue>
 #include <mutex>
+#include <span>
+#include <string>
+#include <utility>
 
 namespace temp2::events {
 
 using EventHandler = std::function<void(Event&)>;
+using BatchEventHandler = std::function<void(std::span<Event* const>)>;
 using HandlerId = size_t;
+using EventFactory = std::function<std::unique_ptr<Event>()>;
+using DispatchObserver = std::function<void(const Event&)>;
+
+/**
+ * @brief How queue_event treats repeated events of one type
+ *
+ * Events that pass the filter (all events when no filter is set) share one
+ * pending slot per coalescing key. The first event of a key takes its place
+ * in its lane like any queued event, counting against the lane's capacity
+ * and backpressure policy; until it is dispatched, KeepLatest replaces it
+ * with each later event of the key and Merge folds them into it. An event
+ * of the type that the filter rejects is queued as usual and closes the
+ * type's pending slots, so later events of the type start new ones and
+ * events of one type are never reordered. Merge requires a merge function.
+ */
+enum class CoalesceMode { KeepAll, KeepLatest, Merge };
+
+struct CoalescePolicy {
+    CoalesceMode mode = CoalesceMode::KeepAll;
+    std::function<bool(const Event&)> filter;                   // Which events coalesce
+    std::function<uint64_t(const Event&)> key;                  // Separate slots per key
+    std::function<void(Event& pending, const Event& incoming)> merge;  // Required for Merge
+};
+
+/**
+ * @brief Queue lane a queued event waits in
+ *
+ * process_queue drains the lanes in weighted rounds, Critical first: each
+ * round takes up to the lane's weight (scaled to the batch size when there
+ * is no time budget) from every lane, so bulk work never starves but cannot
+ * hold up critical events for long.
+ */
+enum class EventLane { Critical, Normal, Bulk };
 
 /**
  * @brief Event dispatcher with priority support
+ *
+ * Handlers are routed by interned EventTypeId, so dispatch is an index into
+ * the routing table followed by a walk of the handler list. The string-based
+ * overloads intern the type name and forward to the ID-based ones.
+ *
+ * Subscribing to a pattern such as "net.*" (or "*" for everything) covers
+ * every type in that namespace at any depth. Wildcard handlers are merged
+ * into the per-type lists when a table version is built, and types interned
+ * later are resolved once on their first dispatch, so dispatch never matches
+ * patterns.
+ *
+ * The routing table is an immutable snapshot behind an RcuPointer: dispatch
+ * reads it without locking, while subscribe copies the affected handler list
+ * and publishes a new version. Subscribing from another thread, or from
+ * inside a handler, never disturbs a running dispatch.
+ *
+ * HandlerIds index a slot map with generation counters, so unsubscribe is
+ * constant time: it tombstones the subscription, which every dispatch skips
+ * from then on, including one already in progress. Tombstoned entries are
+ * compacted out of the table in one pass once they are as many as the live
+ * handlers, or after process_queue.
+ *
+ * Batch handlers take a span of events. dispatch() hands them a span of
+ * one; with batch dispatch enabled, every drained queue batch is grouped by
+ * event type and each group is delivered in one call per batch handler,
+ * while per-event handlers of the same type still see each event in
+ * priority order. Grouping reorders events of different types.
+ *
+ * Handlers subscribed with subscribe_parallel are declared independent of
+ * every other handler of their type. Once start_fan_out has created a
+ * FanOutPool, dispatch runs a priority tier holding several of them
+ * concurrently: each parallel-safe handler is a pool task, and the tier's
+ * other handlers run in order as one more task. Tiers still run one after
+ * another and set_handled still stops dispatch between tiers, but not
+ * within a fanned-out tier. Parallel-safe handlers may call set_handled
+ * and must otherwise treat the event as read-only. Batch dispatch of queued
+ * events does not fan out.
+ *
+ * Coroutines wait for events with co_await next<EventType>(filter). The
+ * awaiting coroutine is linked into a per-type waiter list without any
+ * allocation and is resumed by the dispatch (or process_queue) of the first
+ * matching event, after that event's handlers and whether or not one of them
+ * marked it handled.
+ *
+ * Queued events go through one EventQueue per EventLane whose mode,
+ * capacity and backpressure policy are set by QueueConfig. Events go to the
+ * lane assigned to their type (Normal unless set_lane says otherwise) or the
+ * lane given to queue_event. process_queue(max_duration) stops once the
+ * budget is spent, checking it after every lane chunk; whatever is left
+ * stays queued for the next call. After start_workers, queued events are
+ * handed to a DispatchWorkerPool instead and handled on worker threads;
+ * start_workers and stop_workers must not race with producers.
+ * BackpressurePolicy::Block waits for the thread that drains the queue, so
+ * producers must run on other threads: queue_event from a handler or timer
+ * into a full Block lane throws std::overflow_error.
+ *
+ * Timers live in a TimerWheel. Due timers fire when process_queue or tick
+ * is called: scheduled events are queued like any other event, and timer
+ * callbacks run on the calling thread.
+ *
+ * Metrics are off by default. Once enabled, every dispatch is counted per
+ * type and per handler, and sampled dispatches are timed; see
+ * DispatcherMetrics. Disabled metrics cost a single atomic load per dispatch.
  */
 class EventDispatcher {
 public:
     EventDispatcher();
+    explicit EventDispatcher(const QueueConfig& config);
     ~EventDispatcher();
 
     // Subscribe to events
     HandlerId subscribe(const std::string& event_type, EventHandler handler, int priority = 0);
+    HandlerId subscribe(EventTypeId type_id, EventHandler handler, int priority = 0);
+    HandlerId subscribe_batch(const std::string& event_type, BatchEventHandler handler, int priority = 0);
+    HandlerId subscribe_batch(EventTypeId type_id, BatchEventHandler handler, int priority = 0);
+    HandlerId subscribe_parallel(const std::string& event_type, EventHandler handler, int priority = 0);
+    HandlerId subscribe_parallel(EventTypeId type_id, EventHandler handler, int priority = 0);
     void unsubscribe(HandlerId id);
     void unsubscribe(const std::string& event_type, HandlerId id);
+    void unsubscribe(EventTypeId type_id, HandlerId id);
     void unsubscribe_all(const std::string& event_type);
+    void unsubscribe_all(EventTypeId type_id);
     void clear();
 
     // Dispatch events
     void dispatch(Event& event);
     void dispatch_immediate(Event& event);
+    void dispatch_batch(std::span<Event* const> events);
 
     // Async dispatch
-    void queue_event(std::unique_ptr<Event> event);
+    bool queue_event(std::unique_ptr<Event> event);
+    bool queue_event(std::unique_ptr<Event> event, EventLane lane);
+    bool try_queue_event(std::unique_ptr<Event>& event);
     void process_queue();
+    void process_queue(std::chrono::steady_clock::duration max_duration);
     size_t pending_events() const;
+    size_t dropped_events() const;
+
+    // Timers (due timers fire from process_queue or tick)
+    TimerId schedule_event(std::unique_ptr<Event> event, TimerWheel::Duration delay);
+    TimerId schedule_periodic(EventFactory factory, TimerWheel::Duration interval);
+    TimerId schedule_callback(TimerCallback callback, TimerWheel::Duration delay,
+                              TimerWheel::Duration period = TimerWheel::Duration::zero());
+    bool cancel_timer(TimerId id);
+    size_t tick();
+    size_t pending_timers() const;
+
+    // Coalescing of queued events per type
+    void set_coalescing(const std::string& event_type, CoalescePolicy policy);
+    void set_coalescing(EventTypeId type_id, CoalescePolicy policy);
+    void clear_coalescing();
+    size_t coalesced_events() const;
+
+    // Priority lanes
+    static constexpr size_t LANE_COUNT = 3;
+    void set_lane(const std::string& event_type, EventLane lane);
+    void set_lane(EventTypeId type_id, EventLane lane);
+    EventLane lane_for(EventTypeId type_id) const;
+    void set_lane_weights(size_t critical, size_t normal, size_t bulk);
+    size_t pending_events(EventLane lane) const;
+
+    // Group queued events by type and deliver them to batch handlers together
+    void set_batch_dispatch(bool enabled);
+    bool batch_dispatch() const;
+
+    // Queue configuration. Pending events that fit are carried over and the
+    // rest count as dropped. The queues are replaced without synchronization,
+    // so call this only while no thread is queueing or processing events.
+    void configure_queue(const QueueConfig& config);
+    const QueueConfig& queue_config() const;
+
+    // Event allocation (pooled through EventPool)
+    template <typename EventType, typename... Args>
+    static std::unique_ptr<EventType> make_event(Args&&... args) {
+        return std::make_unique<EventType>(std::forward<Args>(args)...);
+    }
+
+    template <typename EventType>
+    static void reserve_events(size_t count) {
+        EventPool::instance().reserve(sizeof(EventType), count);
+    }
+
+    static EventPool::Stats event_pool_stats();
+
+    // Threaded dispatch (same type in order, different types in parallel).
+    // The pool is not guarded against concurrent use: start and stop it only
+    // while no other thread queues events or calls process_queue
+    void start_workers(size_t thread_count);
+    void stop_workers(bool drain_pending = true);
+    void drain();
+    bool workers_running() const;
+    size_t worker_count() const;
+
+    // Concurrent priority tiers for parallel-safe handlers (configure while idle)
+    void start_fan_out(size_t thread_count);
+    void stop_fan_out();
+    size_t fan_out_threads() const;
+
+    // Coroutine waits (see EventTask); resumed on the dispatching thread
+    template <StaticallyTypedEvent EventType, typename Filter = AcceptAnyEvent>
+        requires std::predicate<Filter&, const EventType&>
+    NextEvent<EventType, Filter> next(Filter filter = Filter()) {
+        return NextEvent<EventType, Filter>(*this, EventType::static_type_id(), std::move(filter));
+    }
+
+    template <typename EventType = Event, typename Filter = AcceptAnyEvent>
+        requires std::derived_from<EventType, Event> && std::predicate<Filter&, const EventType&>
+    NextEvent<EventType, Filter> next(const std::string& event_type, Filter filter = Filter()) {
+        return NextEvent<EventType, Filter>(*this, event_type_registry().intern(event_type), std::move(filter));
+    }
+
+    size_t waiting_coroutines() const;
+
+    // Observers see every dispatched event before its handlers. on_destroyed
+    // runs if the dispatcher is destroyed while the observer is still added,
+    // so its owner can forget the dispatcher instead of calling into it later
+    HandlerId add_observer(DispatchObserver observer, std::function<void()> on_destroyed = {});
+    void remove_observer(HandlerId id);
+
+    // Instrumentation
+    void enable_metrics(const MetricsConfig& config = MetricsConfig());
+    void disable_metrics();
+    bool metrics_enabled() const;
+    MetricsSnapshot metrics_snapshot() const;
+    void reset_metrics();
 
     // Query
     size_t handler_count(const std::string& event_type) const;
+    size_t handler_count(EventTypeId type_id) const;
     bool has_handlers(const std::string& event_type) const;
+    bool has_handlers(EventTypeId type_id) const;
 
 private:
+    // Shared by every table version and wildcard copy of one subscription;
+    // the flags come first so dispatch reads them from the handler's cache line
+    struct Subscription {
+        std::atomic<bool> removed{false};  // Tombstone set by unsubscribe
+        bool parallel_safe = false;        // May run concurrently with its tier
+        EventHandler handler;
+        BatchEventHandler batch_handler;  // Set instead of handler for batch subscriptions
+    };
+
     struct HandlerEntry {
         HandlerId id;
-        EventHandler handler;
+        std::shared_ptr<Subscription> subscription;
         int priority;
+        uint64_t sequence;  // Subscription order; newer first among equal priorities
+        bool wildcard;      // Copy of a pattern subscription
+
+        bool removed() const { return subscription->removed.load(std::memory_order_relaxed); }
     };
 
-    std::map<std::string, std::vector<HandlerEntry>> handlers_;
-    std::queue<std::unique_ptr<Event>> event_queue_;
-    mutable std::mutex queue_mutex_;
+    // HandlerId is generation << 32 | slot index
+    struct HandleSlot {
+        uint32_t generation = 1;
+        bool wildcard = false;
+        EventTypeId type_id = 0;
+        std::string prefix;
+        std::shared_ptr<Subscription> subscription;  // Null while the slot is free
+    };
+
+    static constexpr size_t MIN_COMPACTION = 64;
+
+    using HandlerList = std::vector<HandlerEntry>;
+
+    struct WildcardEntry {
+        std::string prefix;  // "net." for "net.*"
+        HandlerEntry entry;
+    };
+
+    // Routing table indexed by EventTypeId; lists are shared between versions
+    // and already include matching wildcard subscriptions
+    struct HandlerTable {
+        std::vector<std::shared_ptr<const HandlerList>> lists;
+        std::vector<WildcardEntry> wildcards;
+        size_t resolved_types = 0;  // Type IDs below this have wildcards merged in
+    };
+
+    HandlerId add_entry(EventTypeId type_id, std::shared_ptr<Subscription> subscription, int priority);
+    HandlerId add_wildcard(std::string prefix, std::shared_ptr<Subscription> subscription, int priority);
+    HandlerId allocate_handle(EventTypeId type_id, bool wildcard, const std::string& prefix,
+                              const std::shared_ptr<Subscription>& subscription);
+    HandleSlot* find_handle(HandlerId id);
+    void release_handle(HandlerId id);
+    void compact_if_needed();
+    void compact();
+    void compact_after_dispatch();
+    std::unique_ptr<HandlerTable> copy_table();
+    void commit_table(std::unique_ptr<HandlerTable> table);
+    void rebuild_list(HandlerTable& table, EventTypeId type_id);
+    void rebuild_matching(HandlerTable& table, const std::string& prefix);
+    void resolve_new_types();
+
+    void resolve_wildcards(EventTypeId type_id) {
+        if (type_id >= resolved_types_.load(std::memory_order_acquire)) {
+            resolve_new_types();
+        }
+    }
+
+    void dispatch_group(const HandlerList& handler_list, std::span<Event* const> group,
+                        std::vector<Event*>& live);
+    void dispatch_events(std::span<Event* const> events);
+    void dispatch_events_resolved(std::span<Event* const> events);
+    void dispatch_grouped(std::span<Event* const> events, bool queued);
+    void dispatch_measured(Event& event, DispatcherMetrics& metrics, bool queued);
+    size_t dispatch_tier(const HandlerList& handler_list, size_t first, Event& event, FanOutPool& fan_out);
+    void dispatch_group_measured(const HandlerList& handler_list, std::span<Event* const> group,
+                                 std::vector<Event*>& live, DispatcherMetrics& metrics, bool queued);
+    void record_queue_depth();
+    void notify_observers(const Event& event);
+    void resume_waiters(Event& event);
+
+    friend class EventWaiter;
+    void add_waiter(EventWaiter& waiter);
+    void remove_waiter(EventWaiter& waiter);
+    TimerId add_timer(TimerTask task, TimerWheel::Duration delay, TimerWheel::Duration period);
+    struct CoalesceSlot;
+    class CoalescedEvent;
+    bool coalesce(std::unique_ptr<Event>& event, std::shared_ptr<CoalesceSlot>& opened);
+    void open_coalesce_slot(const std::shared_ptr<CoalesceSlot>& slot);
+    std::unique_ptr<Event> take_coalesced(CoalescedEvent& placeholder);
+    static EventTypeId routed_type(const Event& event);
+    EventQueue& lane_queue(EventLane lane);
+    void drain_queues(const std::chrono::steady_clock::time_point* deadline);
+
+    struct LaneTable {
+        std::vector<EventLane> lanes;  // Indexed by EventTypeId
+    };
+
+    struct ObserverEntry {
+        HandlerId id;
+        DispatchObserver observer;
+        std::function<void()> on_destroyed;
+    };
+
+    struct ObserverTable {
+        std::vector<ObserverEntry> observers;
+    };
+
+    struct CoalesceTable {
+        std::vector<std::shared_ptr<const CoalescePolicy>> policies;
+    };
+
+    RcuPointer<HandlerTable> handlers_;
+    std::mutex handlers_mutex_;  // Serializes writers of handlers_
+    std::atomic<size_t> resolved_types_;  // SIZE_MAX while there are no wildcards
+    std::vector<HandleSlot> handles_;     // Guarded by handlers_mutex_
+    std::vector<uint32_t> free_handles_;
+    size_t live_handles_;
+    std::atomic<size_t> tombstones_;  // Removed entries still in the table
+    std::array<std::unique_ptr<EventQueue>, LANE_COUNT> queues_;
+    std::atomic<size_t> retired_dropped_;  // Drops of queues replaced by configure_queue
+    std::array<std::atomic<size_t>, LANE_COUNT> lane_weights_;
+    RcuPointer<LaneTable> lane_table_;
+    std::atomic<bool> lane_routing_;  // False until set_lane is first called
+    std::mutex lanes_mutex_;         // Serializes writers of lane_table_
+    std::unique_ptr<DispatchWorkerPool> workers_;
+    std::unique_ptr<FanOutPool> fan_out_;
+    std::atomic<bool> batch_dispatch_;
+
+    RcuPointer<CoalesceTable> coalesce_policies_;
+    std::atomic<bool> coalescing_enabled_;
+    mutable std::mutex coalesce_mutex_;  // Guards the slots and serializes policy writers
+    std::map<std::pair<EventTypeId, uint64_t>, std::shared_ptr<CoalesceSlot>> coalesce_index_;
+    std::atomic<size_t> coalesced_;
+
+    RcuPointer<ObserverTable> observers_;
+    std::atomic<bool> observing_;
+
+    std::deque<WaiterLink> waiter_lists_;  // Indexed by EventTypeId; deque keeps heads in place
+    mutable std::mutex waiters_mutex_;
+    std::atomic<size_t> waiting_;
+
+    TimerWheel timers_;
+    mutable std::mutex timers_mutex_;
+    std::atomic<size_t> timer_count_;  // Lets process_queue skip the lock when idle
+
+    std::atomic<DispatcherMetrics*> metrics_;      // Null while metrics are disabled
+    std::unique_ptr<DispatcherMetrics> metrics_storage_;  // Kept after disable for snapshots
+    mutable std::mutex metrics_mutex_;
+
     HandlerId next_id_;
 };
 
@@ -65,8 +418,10 @@ public:
     HandlerId subscribe(const std::string& event_type, EventHandler handler, int priority = 0);
     void unsubscribe(HandlerId id);
     void dispatch(Event& event);
-    void queue_event(std::unique_ptr<Event> event);
+    bool queue_event(std::unique_ptr<Event> event);
     void process_queue();
+    void process_queue(std::chrono::steady_clock::duration max_duration);
+    void configure_queue(const QueueConfig& config);
 
     // Delete copy and move
     EventBus(const EventBus&) = delete;
@@ -1,15 +1,25 @@
 #ifndef TEMP2_EVENTS_EVENT_HPP
 #define TEMP2_EVENTS_EVENT_HPP
 
+#include "attributes.hpp"
+#include "event_pool.hpp"
+#include "registry.hpp"
+#include <cstddef>
 #include <string>
 #include <any>
 #include <chrono>
-#include <map>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
 
 namespace temp2::events {
 
 /**
  * @brief Base event class
+ *
+ * Heap-allocated events of every subclass are served by EventPool, so
+ * std::make_unique<MouseEvent>(...) recycles memory from previously
+ * destroyed events instead of calling malloc.
  */
 class Event {
 public:
@@ -19,26 +29,67 @@ public:
     explicit Event(const std::string& type);
     virtual ~Event() = default;
 
+    // Pooled allocation (the virtual destructor passes the dynamic size)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+    static void* operator new(std::size_t, void* place) noexcept { return place; }
+    static void operator delete(void*, void*) noexcept {}
+
+    // Copy of the event including its data, timestamp and handled flag.
+    // Every subclass must override it; the base version throws
+    // std::logic_error rather than slice a subclass
+    virtual std::unique_ptr<Event> clone() const;
+
     const std::string& type() const;
+    EventTypeId type_id() const;
     Timestamp timestamp() const;
     bool is_handled() const;
     void set_handled(bool handled = true);
 
-    // Data storage
+    // Data storage (keys are interned; see AttributeStore)
     void set_data(const std::string& key, const std::any& value);
+    void set_data(AttributeKey key, const std::any& value);
     std::any get_data(const std::string& key) const;
     bool has_data(const std::string& key) const;
+    bool has_data(AttributeKey key) const;
+    const AttributeStore& attributes() const;
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, std::any>>>
+    void set_data(const std::string& key, T&& value) {
+        set_data(attribute_key_registry().intern(key), std::forward<T>(value));
+    }
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, std::any>>>
+    void set_data(AttributeKey key, T&& value) {
+        data_.set(key, AttributeValue::from(std::forward<T>(value)));
+    }
 
     template <typename T>
     T get_data_as(const std::string& key) const {
-        return std::any_cast<T>(data_.at(key));
+        auto key_id = attribute_key_registry().find(key);
+        if (!key_id) {
+            throw std::out_of_range("No event data for key: " + key);
+        }
+        return get_data_as<T>(*key_id);
+    }
+
+    template <typename T>
+    T get_data_as(AttributeKey key) const {
+        const AttributeValue* value = data_.find(key);
+        if (!value) {
+            throw std::out_of_range("No event data for key");
+        }
+        return value->as<T>();
     }
 
 protected:
-    std::string type_;
+    explicit Event(const NameRegistry::Entry& type);
+
+    const std::string* type_;  // Interned name owned by event_type_registry()
+    EventTypeId type_id_;
     Timestamp timestamp_;
     bool handled_;
-    std::map<std::string, std::any> data_;
+    AttributeStore data_;
 };
 
 /**
@@ -51,6 +102,10 @@ public:
 
     MouseEvent(Action action, double x, double y, Button button = Button::None);
 
+    std::unique_ptr<Event> clone() const override;
+
+    static EventTypeId static_type_id();
+
     Action action() const;
     Button button() const;
     double x() const;
@@ -76,6 +131,10 @@ public:
 
     KeyboardEvent(Action action, int key_code, int modifiers = 0);
 
+    std::unique_ptr<Event> clone() const override;
+
+    static EventTypeId static_type_id();
+
     Action action() const;
     int key_code() const;
     int modifiers() const;
@@ -105,6 +164,10 @@ public:
     WindowEvent(Action action, int width, int height);
     WindowEvent(Action action, int x, int y, bool is_position);
 
+    std::unique_ptr<Event> clone() const override;
+
+    static EventTypeId static_type_id();
+
     Action action() const;
     int width() const;
     int height() const;
@@ -126,6 +189,10 @@ class CustomEvent : public Event {
 public:
     explicit CustomEvent(const std::string& name);
 
+    std::unique_ptr<Event> clone() const override;
+
+    static EventTypeId static_type_id();
+
     const std::string& name() const;
 
 private:
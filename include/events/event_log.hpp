@@ -0,0 +1,156 @@
+#ifndef TEMP2_EVENTS_EVENT_LOG_HPP
+#define TEMP2_EVENTS_EVENT_LOG_HPP
+
+#include "dispatcher.hpp"
+#include "event.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace temp2::events {
+
+/**
+ * @brief Binary event log layout
+ *
+ * A 16-byte header (MAGIC, FORMAT_VERSION, reserved) is followed by
+ * records, each a little-endian uint32 body length and the body:
+ *
+ *   u8 kind, u64 offset_ns since recording start, str16 type,
+ *   kind-specific fields, u16 attribute count, attributes
+ *
+ * Mouse, keyboard and window events store their fields; custom events
+ * their name. Attributes are str16 key, u8 tag and the value (bool as u8,
+ * int as i32, int64 as i64, double as IEEE bits, str32 string). Attributes
+ * held as std::any cannot be serialized and are skipped. Records are only
+ * ever appended, so a log cut short by a crash is read up to its last
+ * complete record.
+ */
+namespace event_log {
+
+constexpr char MAGIC[8] = {'T', '2', 'E', 'V', 'L', 'O', 'G', '\0'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 16;
+
+enum class RecordKind : uint8_t { Generic, Mouse, Keyboard, Window, Custom };
+enum class AttributeTag : uint8_t { Bool, Int, Int64, Double, String };
+
+}  // namespace event_log
+
+/**
+ * @brief Appends dispatched events to a binary event log
+ *
+ * Attached to a dispatcher, the recorder observes every dispatched event;
+ * a dispatcher destroyed first detaches it. Records are buffered and
+ * written in large blocks; record() is safe to call from several dispatch
+ * threads. An event that cannot be encoded (a type, name or attribute key
+ * over 65535 bytes) leaves the log untouched: record() throws
+ * std::length_error, and an attached recorder counts it in
+ * skipped_events() instead of failing the dispatch.
+ */
+class EventRecorder {
+public:
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    explicit EventRecorder(const std::string& path);
+    ~EventRecorder();
+
+    // Delete copy
+    EventRecorder(const EventRecorder&) = delete;
+    EventRecorder& operator=(const EventRecorder&) = delete;
+
+    void attach(EventDispatcher& dispatcher);
+    void detach();
+
+    void record(const Event& event);
+    void flush();
+
+    size_t recorded() const;
+    size_t skipped_attributes() const;
+    size_t skipped_events() const;
+
+private:
+    void observe(const Event& event);
+    void write_buffer();
+
+    std::ofstream out_;
+    std::chrono::steady_clock::time_point start_;
+    mutable std::mutex mutex_;
+    std::vector<unsigned char> buffer_;
+    std::vector<unsigned char> scratch_;  // The record being encoded
+    size_t recorded_;
+    size_t skipped_attributes_;
+    size_t skipped_events_;
+    EventDispatcher* dispatcher_;
+    HandlerId observer_id_;
+};
+
+/**
+ * @brief Memory-mapped sequential reader for event logs
+ */
+class EventLogReader {
+public:
+    struct Record {
+        std::unique_ptr<Event> event;
+        std::chrono::nanoseconds offset;  // Since the start of the recording
+    };
+
+    explicit EventLogReader(const std::string& path);
+    ~EventLogReader();
+
+    // Delete copy
+    EventLogReader(const EventLogReader&) = delete;
+    EventLogReader& operator=(const EventLogReader&) = delete;
+
+    // Decode the next record; false at the end of the log
+    bool next(Record& record);
+    void rewind();
+
+    size_t size_bytes() const;
+    size_t position() const;
+
+private:
+    const unsigned char* data_;
+    size_t size_;
+    size_t position_;
+};
+
+enum class ReplayMode {
+    RealTime,         // Keep the recorded spacing between events
+    AsFastAsPossible
+};
+
+struct ReplayOptions {
+    ReplayMode mode = ReplayMode::AsFastAsPossible;
+    double speed = 1.0;   // RealTime only: 2.0 replays twice as fast
+    bool queued = false;  // Go through queue_event/process_queue instead of dispatch
+};
+
+struct ReplayStats {
+    size_t events;
+    size_t bytes;
+    double seconds;
+    double events_per_second;
+    double megabytes_per_second;
+};
+
+/**
+ * @brief Feeds an event log back into a dispatcher
+ */
+class EventReplayer {
+public:
+    explicit EventReplayer(const std::string& path);
+
+    ReplayStats replay(EventDispatcher& dispatcher, const ReplayOptions& options = ReplayOptions());
+
+private:
+    EventLogReader reader_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_EVENT_LOG_HPP
@@ -0,0 +1,83 @@
+#ifndef TEMP2_EVENTS_EVENT_POOL_HPP
+#define TEMP2_EVENTS_EVENT_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+namespace temp2::events {
+
+/**
+ * @brief Size-class block allocator backing Event::operator new
+ *
+ * Blocks come in multiples of BLOCK_SIZE up to MAX_BLOCK_SIZE and are carved
+ * from chunks of BLOCKS_PER_CHUNK. Each thread keeps a small free list per
+ * size class and exchanges blocks with a shared depot in batches, so a
+ * steady stream of events recycles memory without calling malloc. Larger
+ * requests fall through to ::operator new. Chunks are never returned to the
+ * system: the pool lives for the whole process so events destroyed during
+ * static destruction stay valid.
+ */
+class EventPool {
+public:
+    struct Stats {
+        size_t chunk_allocations;
+        size_t reserved_bytes;
+        size_t oversize_allocations;
+    };
+
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t MAX_BLOCK_SIZE = 1024;
+    static constexpr size_t CLASS_COUNT = MAX_BLOCK_SIZE / BLOCK_SIZE;
+    static constexpr size_t BLOCKS_PER_CHUNK = 64;
+    static constexpr size_t THREAD_CACHE_LIMIT = 256;
+    static constexpr size_t TRANSFER_BATCH = 32;
+
+    static EventPool& instance();
+
+    void* allocate(size_t size);
+    void deallocate(void* ptr, size_t size);
+
+    // Pre-populate the depot so the next count allocations of size bytes are served from it
+    void reserve(size_t size, size_t count);
+    Stats stats() const;
+
+    // Delete copy
+    EventPool(const EventPool&) = delete;
+    EventPool& operator=(const EventPool&) = delete;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+
+        void push(FreeBlock* block);
+        FreeBlock* pop();
+    };
+
+    struct ThreadCache;
+
+    EventPool();
+
+    static ThreadCache* thread_cache();
+    static size_t size_class(size_t size);
+
+    void refill(FreeList& list, size_t size_class);
+    void release(FreeList& list, size_t size_class, size_t count);
+    void allocate_chunk(size_t size_class);
+
+    std::array<FreeList, CLASS_COUNT> depot_;
+    mutable std::mutex mutex_;
+    size_t chunk_allocations_;
+    size_t reserved_bytes_;
+    std::atomic<size_t> oversize_allocations_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_EVENT_POOL_HPP
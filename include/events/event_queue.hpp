@@ -0,0 +1,142 @@
+#ifndef TEMP2_EVENTS_EVENT_QUEUE_HPP
+#define TEMP2_EVENTS_EVENT_QUEUE_HPP
+
+#include "event.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace temp2::events {
+
+/**
+ * @brief Storage strategy for queued events
+ */
+enum class QueueMode {
+    Locked,    // Mutex-guarded deque, unbounded unless a capacity is set
+    LockFree   // Bounded multi-producer/multi-consumer ring buffer
+};
+
+/**
+ * @brief What push does when a bounded queue is full
+ *
+ * Block waits for another thread to pop, so it needs a consumer thread
+ * separate from the producers. A thread inside an EventQueue::ConsumerScope
+ * (the dispatcher's process_queue, tick and worker threads) would wait for
+ * itself, so a Block push from it fails as with Fail instead.
+ */
+enum class BackpressurePolicy {
+    Block,       // Wait until a consumer frees a slot
+    DropOldest,  // Discard the oldest queued event to make room
+    DropNewest,  // Discard the incoming event
+    Fail         // Throw std::overflow_error
+};
+
+/**
+ * @brief Event queue configuration
+ */
+struct QueueConfig {
+    QueueMode mode = QueueMode::Locked;
+    size_t capacity = 0;  // 0 = unbounded (Locked) or DEFAULT_CAPACITY (LockFree)
+    BackpressurePolicy policy = BackpressurePolicy::Block;
+    size_t batch_size = 256;  // Events drained per batch by the dispatcher
+
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+};
+
+/**
+ * @brief Bounded lock-free MPMC ring buffer of owned event pointers
+ *
+ * Each cell carries a sequence number that tells producers and consumers
+ * whether it is free for the current lap, so push and pop are a single CAS
+ * on their respective cursor. Capacity is rounded up to a power of two.
+ */
+class EventRingBuffer {
+public:
+    explicit EventRingBuffer(size_t capacity);
+    ~EventRingBuffer();
+
+    // Delete copy
+    EventRingBuffer(const EventRingBuffer&) = delete;
+    EventRingBuffer& operator=(const EventRingBuffer&) = delete;
+
+    bool try_push(Event* event);
+    Event* try_pop();
+
+    size_t size() const;
+    size_t capacity() const;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Event* event;
+    };
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeue_pos_;
+};
+
+/**
+ * @brief Thread-safe event queue with configurable backpressure
+ */
+class EventQueue {
+public:
+    /**
+     * @brief Marks the calling thread as a queue consumer while in scope
+     */
+    class ConsumerScope {
+    public:
+        ConsumerScope();
+        ~ConsumerScope();
+
+        // Delete copy
+        ConsumerScope(const ConsumerScope&) = delete;
+        ConsumerScope& operator=(const ConsumerScope&) = delete;
+    };
+
+    explicit EventQueue(const QueueConfig& config = QueueConfig());
+    ~EventQueue();
+
+    // Delete copy
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // Producers
+    bool push(std::unique_ptr<Event> event);
+    bool try_push(std::unique_ptr<Event>& event);
+
+    // Consumers
+    std::unique_ptr<Event> pop();
+    size_t pop_batch(std::vector<std::unique_ptr<Event>>& out, size_t max_count);
+    void clear();
+
+    // Query
+    size_t size() const;
+    bool empty() const;
+    size_t capacity() const;
+    size_t dropped() const;
+    const QueueConfig& config() const;
+
+private:
+    bool push_locked(std::unique_ptr<Event>& event);
+    bool push_lock_free(std::unique_ptr<Event>& event);
+    void notify_space();
+
+    QueueConfig config_;
+    std::unique_ptr<EventRingBuffer> ring_;
+    std::deque<std::unique_ptr<Event>> deque_;
+    mutable std::mutex mutex_;
+    std::condition_variable space_available_;
+    std::atomic<size_t> dropped_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_EVENT_QUEUE_HPP
@@ -4,6 +4,7 @@
 #include "event.hpp"
 #include "dispatcher.hpp"
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 namespace temp2::events {
@@ -69,10 +70,12 @@ public:
     using HandlerFunc = std::function<void(EventType&)>;
 
     explicit AutoEventHandler(const std::string& event_type, HandlerFunc handler)
-        : event_type_(event_type), handler_(std::move(handler)) {}
+        : event_type_(event_type)
+        , type_id_(event_type_registry().intern(event_type))
+        , handler_(std::move(handler)) {}
 
     void handle(Event& event) override {
-        if (handler_ && event.type() == event_type_) {
+        if (handler_ && event.type_id() == type_id_) {
             handler_(static_cast<EventType&>(event));
         }
     }
@@ -83,6 +86,7 @@ public:
 
 private:
     std::string event_type_;
+    EventTypeId type_id_;
     HandlerFunc handler_;
 };
 
@@ -126,6 +130,52 @@ private:
     Clock::time_point last_call_;
 };
 
+/**
+ * @brief Debounced handler with trailing-edge delivery
+ *
+ * Every event restarts a timer on the dispatcher; once no event has arrived
+ * for the delay, the handler receives a copy of the last one. Delivery runs
+ * on the thread calling process_queue or tick. Copies share their state, so
+ * the handler can be passed to subscribe directly.
+ */
+class TrailingDebouncedHandler {
+public:
+    using HandlerFunc = std::function<void(Event&)>;
+    using Duration = std::chrono::milliseconds;
+
+    TrailingDebouncedHandler(EventDispatcher& dispatcher, HandlerFunc handler, Duration delay);
+
+    void operator()(Event& event);
+    void reset();
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Throttled handler with leading and trailing-edge delivery
+ *
+ * The first event opens a window of one interval and is delivered at once.
+ * Events arriving while the window is open are held back; when it closes
+ * the last of them is delivered and a new window opens. No clock is read
+ * per event: windows are timers on the dispatcher.
+ */
+class TrailingThrottledHandler {
+public:
+    using HandlerFunc = std::function<void(Event&)>;
+    using Duration = std::chrono::milliseconds;
+
+    TrailingThrottledHandler(EventDispatcher& dispatcher, HandlerFunc handler, Duration interval);
+
+    void operator()(Event& event);
+    void reset();
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
 /**
  * @brief Once handler - only fires once
  */
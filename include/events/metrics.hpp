@@ -0,0 +1,112 @@
+#ifndef TEMP2_EVENTS_METRICS_HPP
+#define TEMP2_EVENTS_METRICS_HPP
+
+#include "registry.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace temp2::events {
+
+/**
+ * @brief Metrics collection settings
+ */
+struct MetricsConfig {
+    uint32_t sample_every = 1;  // Time one dispatch in N per thread (0: counts only)
+};
+
+/**
+ * @brief Merged latency statistics
+ *
+ * Histogram bucket i counts samples in [2^i, 2^(i+1)) nanoseconds; bucket 0
+ * also holds zero-length samples and the last bucket everything above.
+ */
+struct LatencyStats {
+    static constexpr size_t BUCKETS = 40;
+
+    uint64_t samples = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    std::array<uint64_t, BUCKETS> histogram{};
+
+    double mean_ns() const;
+    uint64_t percentile_ns(double percentile) const;
+};
+
+struct TypeMetrics {
+    EventTypeId type_id;
+    std::string type_name;
+    uint64_t dispatches;
+    LatencyStats dispatch_latency;  // Whole handler walk (per type group in batch mode)
+    LatencyStats queue_wait;        // Event::timestamp() to dispatch, queued events only
+};
+
+struct HandlerMetrics {
+    size_t handler_id;
+    EventTypeId type_id;
+    uint64_t invocations;
+    LatencyStats latency;
+};
+
+struct MetricsSnapshot {
+    std::vector<TypeMetrics> types;
+    std::vector<HandlerMetrics> handlers;
+    size_t queue_high_water;
+};
+
+/**
+ * @brief Low-overhead dispatcher instrumentation
+ *
+ * Every thread records into its own shard with relaxed stores, so the hot
+ * path never contends with other threads; shards are merged when a snapshot
+ * is taken. Timing is sampled per thread according to MetricsConfig.
+ */
+class DispatcherMetrics {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit DispatcherMetrics(const MetricsConfig& config = MetricsConfig());
+    ~DispatcherMetrics();
+
+    // Delete copy
+    DispatcherMetrics(const DispatcherMetrics&) = delete;
+    DispatcherMetrics& operator=(const DispatcherMetrics&) = delete;
+
+    void configure(const MetricsConfig& config);
+
+    // Recording (called by the dispatcher)
+    bool should_sample();
+    static uint64_t elapsed_ns(Clock::time_point start, Clock::time_point end);
+    void record_dispatch(EventTypeId type_id, uint64_t events, bool sampled, uint64_t elapsed_ns);
+    void record_handler(EventTypeId type_id, size_t handler_id, bool sampled, uint64_t elapsed_ns);
+    void record_queue_wait(EventTypeId type_id, uint64_t wait_ns);
+    void record_queue_depth(size_t depth);
+
+    // Reading
+    MetricsSnapshot snapshot() const;
+    void reset();
+
+private:
+    struct LatencyCounter;
+    struct TypeCounters;
+    struct HandlerCounters;
+    struct Shard;
+
+    Shard& local_shard();
+
+    const uint64_t instance_id_;
+    std::atomic<uint32_t> sample_every_;
+    std::atomic<size_t> queue_high_water_;
+    mutable std::mutex shards_mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_METRICS_HPP
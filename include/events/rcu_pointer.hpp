@@ -0,0 +1,107 @@
+#ifndef TEMP2_EVENTS_RCU_POINTER_HPP
+#define TEMP2_EVENTS_RCU_POINTER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace temp2::events {
+
+/**
+ * @brief Read-copy-update holder for an immutable snapshot
+ *
+ * Readers pin the current version with a ReadGuard: an epoch check plus one
+ * counter increment, no locks. Writers build a new version and publish it;
+ * replaced versions are retired and freed once every reader that could still
+ * see them has left. Reclamation never waits, so a reader may publish (for
+ * example a handler that unsubscribes itself). Writers must be serialized
+ * by the caller.
+ */
+template <typename T>
+class RcuPointer {
+public:
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const RcuPointer& owner) : owner_(owner) {
+            for (;;) {
+                slot_ = owner_.epoch_.load(std::memory_order_seq_cst) & 1;
+                owner_.readers_[slot_].fetch_add(1, std::memory_order_seq_cst);
+                if ((owner_.epoch_.load(std::memory_order_seq_cst) & 1) == slot_) break;
+                owner_.readers_[slot_].fetch_sub(1, std::memory_order_release);
+            }
+            snapshot_ = owner_.current_.load(std::memory_order_seq_cst);
+        }
+
+        ~ReadGuard() {
+            owner_.readers_[slot_].fetch_sub(1, std::memory_order_release);
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const T* get() const { return snapshot_; }
+        const T* operator->() const { return snapshot_; }
+        const T& operator*() const { return *snapshot_; }
+
+    private:
+        const RcuPointer& owner_;
+        const T* snapshot_;
+        uint64_t slot_;
+    };
+
+    RcuPointer() : RcuPointer(std::make_unique<T>()) {}
+
+    explicit RcuPointer(std::unique_ptr<T> initial)
+        : current_(initial.release()), epoch_(0) {
+        readers_[0].store(0, std::memory_order_relaxed);
+        readers_[1].store(0, std::memory_order_relaxed);
+    }
+
+    ~RcuPointer() {
+        delete current_.load(std::memory_order_acquire);
+        for (const T* retired : pending_) delete retired;
+        for (const T* retired : grace_) delete retired;
+    }
+
+    RcuPointer(const RcuPointer&) = delete;
+    RcuPointer& operator=(const RcuPointer&) = delete;
+
+    ReadGuard read() const { return ReadGuard(*this); }
+
+    // Current version as seen by the (serialized) writer
+    const T& writer_view() const { return *current_.load(std::memory_order_acquire); }
+
+    void publish(std::unique_ptr<T> next) {
+        const T* previous = current_.exchange(next.release(), std::memory_order_seq_cst);
+        pending_.push_back(previous);
+        reclaim();
+    }
+
+    void reclaim() {
+        uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+
+        // grace_ was retired before the flip to the current epoch; only
+        // readers counted under the previous epoch can still hold it
+        if (readers_[(epoch - 1) & 1].load(std::memory_order_seq_cst) != 0) return;
+
+        for (const T* retired : grace_) delete retired;
+        grace_.clear();
+
+        if (!pending_.empty()) {
+            std::swap(grace_, pending_);
+            epoch_.store(epoch + 1, std::memory_order_seq_cst);
+        }
+    }
+
+private:
+    std::atomic<const T*> current_;
+    mutable std::atomic<uint64_t> epoch_;
+    mutable std::atomic<int64_t> readers_[2];
+    std::vector<const T*> pending_;
+    std::vector<const T*> grace_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_RCU_POINTER_HPP
@@ -0,0 +1,59 @@
+#ifndef TEMP2_EVENTS_REGISTRY_HPP
+#define TEMP2_EVENTS_REGISTRY_HPP
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace temp2::events {
+
+/**
+ * @brief Thread-safe string interner mapping names to dense integer IDs
+ *
+ * IDs are assigned sequentially from 0 and never reused, so they can index
+ * flat routing tables directly. Returned name references stay valid for the
+ * lifetime of the registry.
+ */
+class NameRegistry {
+public:
+    using Id = uint32_t;
+
+    struct Entry {
+        Id id;
+        const std::string* name;
+    };
+
+    NameRegistry();
+
+    // Interning
+    Id intern(const std::string& name);
+    Entry intern_entry(const std::string& name);
+    std::optional<Id> find(const std::string& name) const;
+
+    // Query
+    const std::string& name(Id id) const;
+    size_t size() const;
+
+    // Delete copy
+    NameRegistry(const NameRegistry&) = delete;
+    NameRegistry& operator=(const NameRegistry&) = delete;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, Id> ids_;
+    std::deque<std::string> names_;
+};
+
+using EventTypeId = NameRegistry::Id;
+
+/**
+ * @brief Process-wide registry of event type names
+ */
+NameRegistry& event_type_registry();
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_REGISTRY_HPP
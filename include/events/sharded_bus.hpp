@@ -0,0 +1,83 @@
+#ifndef TEMP2_EVENTS_SHARDED_BUS_HPP
+#define TEMP2_EVENTS_SHARDED_BUS_HPP
+
+#include "dispatcher.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace temp2::events {
+
+using ShardId = size_t;
+
+/**
+ * @brief Event bus split into independent per-thread shards
+ *
+ * Each shard is its own EventDispatcher with its own handler table and a
+ * lock-free inbox (its event queue in QueueMode::LockFree), so threads that
+ * own different shards never touch shared state on the dispatch path. Any
+ * thread may post into any shard's inbox; the owning thread drains it with
+ * process(). Threads bind to a shard once and then use the *_local calls.
+ *
+ * Global subscriptions are replicated to every shard and share one handler
+ * object, which may therefore be invoked from several shard threads at once.
+ * Shard subscriptions only see events handled by that shard.
+ */
+class ShardedEventBus {
+public:
+    explicit ShardedEventBus(size_t shard_count, const QueueConfig& inbox_config = default_inbox_config());
+    ~ShardedEventBus();
+
+    // Delete copy
+    ShardedEventBus(const ShardedEventBus&) = delete;
+    ShardedEventBus& operator=(const ShardedEventBus&) = delete;
+
+    static QueueConfig default_inbox_config();
+
+    // Shards
+    size_t shard_count() const;
+    ShardId shard_for(uint64_t key) const;
+    EventDispatcher& shard(ShardId shard);
+
+    // Thread binding
+    void bind_current_thread(ShardId shard);
+    void unbind_current_thread();
+    std::optional<ShardId> current_shard() const;
+    EventDispatcher& local();
+
+    // Subscribe to events (global subscriptions are replicated to all shards)
+    HandlerId subscribe(const std::string& event_type, EventHandler handler, int priority = 0);
+    HandlerId subscribe(ShardId shard, const std::string& event_type, EventHandler handler, int priority = 0);
+    void unsubscribe(HandlerId id);
+
+    // Cross-shard delivery into the owning shard's inbox
+    bool post(ShardId shard, std::unique_ptr<Event> event);
+    bool post_keyed(uint64_t key, std::unique_ptr<Event> event);
+    size_t broadcast(const Event& event);
+
+    // Owner-side processing
+    void dispatch_local(Event& event);
+    void process(ShardId shard);
+    void process_local();
+    size_t pending_events(ShardId shard) const;
+
+private:
+    const std::unique_ptr<EventDispatcher>& checked(ShardId shard) const;
+
+    const uint64_t instance_id_;
+    std::vector<std::unique_ptr<EventDispatcher>> shards_;
+
+    std::mutex subscriptions_mutex_;
+    std::unordered_map<HandlerId, std::vector<std::pair<ShardId, HandlerId>>> subscriptions_;
+    HandlerId next_id_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_SHARDED_BUS_HPP
@@ -0,0 +1,187 @@
+#ifndef TEMP2_EVENTS_SHM_CHANNEL_HPP
+#define TEMP2_EVENTS_SHM_CHANNEL_HPP
+
+#include "dispatcher.hpp"
+#include "event.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace temp2::events {
+
+/**
+ * @brief Shared-memory layout of an event channel
+ *
+ * The segment is a SegmentHeader followed by a power-of-two number of
+ * WireEvent slots forming a single-producer/single-consumer ring. head and
+ * tail count slots ever written and read; they sit on separate cache lines
+ * so each side only writes its own. All fields are in host byte order, as
+ * both processes run on the same machine.
+ */
+namespace shm_channel {
+
+constexpr char MAGIC[8] = {'T', '2', 'S', 'H', 'M', 'E', 'V', '\0'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t NAME_CAPACITY = 64;
+constexpr size_t PAYLOAD_CAPACITY = 432;
+
+enum class WireKind : uint8_t { Mouse = 1, Keyboard, Window, Custom };
+
+struct MouseFields {
+    uint8_t action;
+    uint8_t button;
+    double x;
+    double y;
+    double scroll_delta;
+};
+
+struct KeyboardFields {
+    uint8_t action;
+    int32_t key_code;
+    int32_t modifiers;
+};
+
+struct WindowFields {
+    uint8_t action;
+    int32_t width;
+    int32_t height;
+    int32_t x;
+    int32_t y;
+};
+
+struct CustomFields {
+    uint8_t name_size;
+    uint16_t payload_size;
+    char name[NAME_CAPACITY];
+    char payload[PAYLOAD_CAPACITY];
+};
+
+struct alignas(64) WireEvent {
+    WireKind kind;
+    union {
+        MouseFields mouse;
+        KeyboardFields keyboard;
+        WindowFields window;
+        CustomFields custom;
+    };
+};
+
+static_assert(sizeof(WireEvent) == 512, "WireEvent layout changed");
+static_assert(std::is_trivially_copyable_v<WireEvent>, "WireEvent must be trivially copyable");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring indices must be address-free atomics");
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_size;
+    uint64_t capacity;
+    std::atomic<uint32_t> ready;  // Set last by the producer
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+};
+
+}  // namespace shm_channel
+
+/**
+ * @brief Producer end of a shared-memory event channel
+ *
+ * Creates the POSIX shared-memory segment (replacing a stale one of the same
+ * name) and unlinks it again on destruction; consumers that already opened
+ * it keep working. post() encodes mouse, keyboard, window and custom events
+ * straight into the next ring slot. A custom event's name and its
+ * PAYLOAD_KEY string attribute travel with it, up to NAME_CAPACITY and
+ * PAYLOAD_CAPACITY bytes. post() and an attached dispatcher must be used
+ * from one thread at a time.
+ */
+class ShmEventProducer {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+    static constexpr const char* PAYLOAD_KEY = "payload";
+
+    explicit ShmEventProducer(const std::string& name, size_t capacity = DEFAULT_CAPACITY);
+    ~ShmEventProducer();
+
+    // Delete copy
+    ShmEventProducer(const ShmEventProducer&) = delete;
+    ShmEventProducer& operator=(const ShmEventProducer&) = delete;
+
+    // False when the ring is full (not counted as dropped); throws for
+    // events that cannot travel
+    bool post(const Event& event);
+
+    // Forward every event dispatched by the dispatcher. Events of other types
+    // are ignored; full-ring drops and custom events whose name or payload do
+    // not fit are counted as dropped. A dispatcher destroyed first detaches
+    // the producer
+    void attach(EventDispatcher& dispatcher);
+    void detach();
+
+    const std::string& name() const;
+    size_t capacity() const;
+    size_t posted() const;
+    size_t dropped() const;
+
+private:
+    // strict: throw for events that cannot travel and leave full-ring
+    // failures to the caller instead of counting a drop
+    bool encode(const Event& event, shm_channel::WireKind kind, bool strict);
+
+    std::string name_;
+    void* mapping_;
+    size_t mapping_size_;
+    shm_channel::SegmentHeader* header_;
+    shm_channel::WireEvent* slots_;
+    uint64_t mask_;
+    uint64_t head_;         // Local copy; only this side writes head
+    uint64_t cached_tail_;  // Refreshed from the segment only when the ring looks full
+    size_t posted_;
+    size_t dropped_;
+    AttributeKey payload_key_;
+    EventDispatcher* dispatcher_;
+    HandlerId observer_id_;
+};
+
+/**
+ * @brief Consumer end of a shared-memory event channel
+ *
+ * Opens a segment created by ShmEventProducer. poll() decodes each pending
+ * slot into an event on the stack, frees the slot and dispatches the event
+ * synchronously into the given dispatcher. Malformed slots are skipped.
+ * Mouse, keyboard and window events never touch the heap; a custom event's
+ * name and payload become std::strings, which allocate only when they
+ * exceed the string's small buffer.
+ */
+class ShmEventConsumer {
+public:
+    explicit ShmEventConsumer(const std::string& name);
+    ~ShmEventConsumer();
+
+    // Delete copy
+    ShmEventConsumer(const ShmEventConsumer&) = delete;
+    ShmEventConsumer& operator=(const ShmEventConsumer&) = delete;
+
+    // Dispatch up to max_events pending events; returns how many were consumed
+    size_t poll(EventDispatcher& dispatcher, size_t max_events = SIZE_MAX);
+
+    size_t pending() const;
+    size_t capacity() const;
+    size_t skipped() const;
+
+private:
+    bool dispatch_slot(const shm_channel::WireEvent& wire, EventDispatcher& dispatcher);
+
+    void* mapping_;
+    size_t mapping_size_;
+    shm_channel::SegmentHeader* header_;
+    const shm_channel::WireEvent* slots_;
+    uint64_t mask_;
+    uint64_t tail_;
+    size_t skipped_;
+    AttributeKey payload_key_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_SHM_CHANNEL_HPP
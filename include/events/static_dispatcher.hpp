@@ -0,0 +1,210 @@
+#ifndef TEMP2_EVENTS_STATIC_DISPATCHER_HPP
+#define TEMP2_EVENTS_STATIC_DISPATCHER_HPP
+
+#include "event.hpp"
+#include "dispatcher.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace temp2::events {
+
+/**
+ * @brief Move-only callable reference for a concrete event type
+ *
+ * Small callables (lambdas capturing a few pointers) are stored inline;
+ * larger ones are boxed on the heap once at subscription. Invocation is a
+ * single call through a per-callable thunk in which the handler body is
+ * inlined; there is no std::function, virtual call or downcast.
+ */
+template <typename EventType>
+class EventDelegate {
+public:
+    static constexpr size_t INLINE_SIZE = 3 * sizeof(void*);
+
+    template <typename Handler,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Handler>, EventDelegate>>>
+    explicit EventDelegate(Handler&& handler) {
+        using F = std::decay_t<Handler>;
+        static_assert(std::is_invocable_v<F&, EventType&>, "Handler must accept EventType&");
+
+        if constexpr (fits_inline<F>()) {
+            new (&storage_) F(std::forward<Handler>(handler));
+            invoke_ = [](void* storage, EventType& event) {
+                (*std::launder(static_cast<F*>(storage)))(event);
+            };
+            manage_ = [](Operation op, void* self, void* other) {
+                F* callable = std::launder(static_cast<F*>(self));
+                if (op == Operation::Move) {
+                    new (other) F(std::move(*callable));
+                }
+                callable->~F();
+            };
+        } else {
+            new (&storage_) F*(new F(std::forward<Handler>(handler)));
+            invoke_ = [](void* storage, EventType& event) {
+                (**static_cast<F**>(storage))(event);
+            };
+            manage_ = [](Operation op, void* self, void* other) {
+                F** boxed = static_cast<F**>(self);
+                if (op == Operation::Move) {
+                    new (other) F*(*boxed);
+                } else {
+                    delete *boxed;
+                }
+            };
+        }
+    }
+
+    EventDelegate(EventDelegate&& other) noexcept
+        : invoke_(other.invoke_), manage_(other.manage_) {
+        manage_(Operation::Move, &other.storage_, &storage_);
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+
+    EventDelegate& operator=(EventDelegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+            manage_(Operation::Move, &other.storage_, &storage_);
+            other.invoke_ = nullptr;
+            other.manage_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~EventDelegate() { reset(); }
+
+    EventDelegate(const EventDelegate&) = delete;
+    EventDelegate& operator=(const EventDelegate&) = delete;
+
+    void operator()(EventType& event) { invoke_(&storage_, event); }
+
+private:
+    enum class Operation { Move, Destroy };
+
+    template <typename F>
+    static constexpr bool fits_inline() {
+        return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+    void reset() {
+        if (manage_) {
+            manage_(Operation::Destroy, &storage_, nullptr);
+            invoke_ = nullptr;
+            manage_ = nullptr;
+        }
+    }
+
+    std::aligned_storage_t<INLINE_SIZE, alignof(std::max_align_t)> storage_;
+    void (*invoke_)(void*, EventType&) = nullptr;
+    void (*manage_)(Operation, void*, void*) = nullptr;
+};
+
+/**
+ * @brief Compile-time typed event dispatcher
+ *
+ * The set of event types is fixed by the template arguments and each type
+ * gets its own handler vector, resolved at compile time. Handlers receive
+ * the concrete event type directly. Priority ordering and the set_handled
+ * short-circuit match EventDispatcher. Unlike EventDispatcher this is a
+ * single-threaded fast path: handlers must not subscribe or unsubscribe on
+ * the dispatcher that is currently calling them.
+ */
+template <typename... EventTypes>
+class StaticDispatcher {
+    static_assert(sizeof...(EventTypes) > 0, "StaticDispatcher needs at least one event type");
+    static_assert((std::is_base_of_v<Event, EventTypes> && ...), "Event types must derive from Event");
+
+public:
+    StaticDispatcher() : next_id_(1) {}
+
+    // Subscribe to events
+    template <typename EventType, typename Handler>
+    HandlerId subscribe(Handler&& handler, int priority = 0) {
+        auto& handler_list = handlers<EventType>();
+        HandlerId id = next_id_++;
+
+        // Insert sorted by priority (higher priority first)
+        auto it = std::lower_bound(handler_list.begin(), handler_list.end(), priority,
+            [](const Entry<EventType>& entry, int value) { return entry.priority > value; });
+        handler_list.insert(it, Entry<EventType>{id, priority,
+            EventDelegate<EventType>(std::forward<Handler>(handler))});
+        return id;
+    }
+
+    void unsubscribe(HandlerId id) {
+        (remove_from<EventTypes>(id) || ...);
+    }
+
+    template <typename EventType>
+    void unsubscribe_all() {
+        handlers<EventType>().clear();
+    }
+
+    void clear() {
+        (handlers<EventTypes>().clear(), ...);
+    }
+
+    // Dispatch events
+    template <typename EventType>
+    void dispatch(EventType& event) {
+        for (auto& entry : handlers<EventType>()) {
+            if (event.is_handled()) break;
+            entry.handler(event);
+        }
+    }
+
+    // Query
+    template <typename EventType>
+    size_t handler_count() const {
+        return std::get<HandlerList<EventType>>(lists_).size();
+    }
+
+    template <typename EventType>
+    bool has_handlers() const {
+        return handler_count<EventType>() > 0;
+    }
+
+private:
+    template <typename EventType>
+    struct Entry {
+        HandlerId id;
+        int priority;
+        EventDelegate<EventType> handler;
+    };
+
+    template <typename EventType>
+    using HandlerList = std::vector<Entry<EventType>>;
+
+    template <typename EventType>
+    HandlerList<EventType>& handlers() {
+        static_assert((std::is_same_v<EventType, EventTypes> || ...),
+                      "Event type is not registered with this StaticDispatcher");
+        return std::get<HandlerList<EventType>>(lists_);
+    }
+
+    template <typename EventType>
+    bool remove_from(HandlerId id) {
+        auto& handler_list = handlers<EventType>();
+        auto it = std::find_if(handler_list.begin(), handler_list.end(),
+            [id](const Entry<EventType>& entry) { return entry.id == id; });
+        if (it == handler_list.end()) return false;
+        handler_list.erase(it);
+        return true;
+    }
+
+    std::tuple<HandlerList<EventTypes>...> lists_;
+    HandlerId next_id_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_STATIC_DISPATCHER_HPP
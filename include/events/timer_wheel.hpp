@@ -0,0 +1,107 @@
+#ifndef TEMP2_EVENTS_TIMER_WHEEL_HPP
+#define TEMP2_EVENTS_TIMER_WHEEL_HPP
+
+#include "event.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace temp2::events {
+
+using TimerId = uint64_t;  // 0 is never a valid timer
+using TimerCallback = std::function<void()>;
+
+/**
+ * @brief Work carried by a timer
+ *
+ * A one-shot timer carries either an event to queue or a callback; periodic
+ * timers carry a callback only, which is shared between firings.
+ */
+struct TimerTask {
+    std::unique_ptr<Event> event;
+    std::shared_ptr<const TimerCallback> callback;
+};
+
+/**
+ * @brief Hierarchical timing wheel
+ *
+ * Time advances in ticks of a fixed resolution. The first level has one
+ * slot per tick for the next LEVEL0_SLOTS ticks; each further level covers
+ * LEVEL_SLOTS times the span of the one below and is cascaded down as the
+ * lower level wraps. Deadlines beyond the last level wait in its farthest
+ * slot and are re-filed when it cascades.
+ *
+ * Timers live in a slab indexed by the low half of their TimerId and are
+ * linked into slots intrusively, so schedule and cancel are O(1) and do not
+ * allocate once the slab has grown. The high half of the id is a generation
+ * counter, which makes stale ids harmless. The wheel is not thread-safe.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+
+    static constexpr size_t LEVEL0_BITS = 8;
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t LEVELS = 4;
+    static constexpr size_t LEVEL0_SLOTS = size_t{1} << LEVEL0_BITS;
+    static constexpr size_t LEVEL_SLOTS = size_t{1} << LEVEL_BITS;
+
+    explicit TimerWheel(Duration resolution = std::chrono::milliseconds(1),
+                        Clock::time_point origin = Clock::now());
+
+    // Delete copy
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // A non-zero period re-arms the timer after every firing
+    TimerId schedule(Clock::time_point deadline, TimerTask task, Duration period = Duration::zero());
+    bool cancel(TimerId id);
+    bool is_pending(TimerId id) const;
+    void clear();
+
+    // Move every timer due at or before now into expired (periodic tasks are copied)
+    size_t advance(Clock::time_point now, std::vector<TimerTask>& expired);
+
+    size_t size() const;
+    bool empty() const;
+    Duration resolution() const;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr size_t SLOT_COUNT = LEVEL0_SLOTS + (LEVELS - 1) * LEVEL_SLOTS;
+
+    struct Timer {
+        uint32_t generation = 1;
+        uint32_t slot = NONE;  // NONE while free
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint64_t expires = 0;
+        uint64_t period = 0;
+        TimerTask task;
+    };
+
+    uint64_t to_tick(Clock::time_point time) const;
+    size_t slot_for(uint64_t expires) const;
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(size_t level);
+    void expire_slot(size_t slot, std::vector<TimerTask>& expired);
+
+    Duration resolution_;
+    Clock::time_point origin_;
+    uint64_t current_tick_;
+    std::array<uint32_t, SLOT_COUNT> slots_;
+    std::vector<Timer> timers_;
+    std::vector<uint32_t> free_;
+    size_t active_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_TIMER_WHEEL_HPP
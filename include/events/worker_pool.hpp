@@ -0,0 +1,135 @@
+#ifndef TEMP2_EVENTS_WORKER_POOL_HPP
+#define TEMP2_EVENTS_WORKER_POOL_HPP
+
+#include "event.hpp"
+#include "event_queue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace temp2::events {
+
+/**
+ * @brief Pool of worker threads that dispatch queued events
+ *
+ * Every worker owns a lane and events are routed to lane
+ * type_id % thread_count, so events of the same type are handled in
+ * submission order by one thread while different types run in parallel.
+ * The route overloads place an event as if it had the given type.
+ * Lanes are EventQueues built from the supplied QueueConfig, and each
+ * drained lane batch is handed to the dispatch callback in one call.
+ */
+class DispatchWorkerPool {
+public:
+    using DispatchFunc = std::function<void(std::span<Event* const>)>;
+
+    DispatchWorkerPool(size_t thread_count, const QueueConfig& lane_config, DispatchFunc dispatch);
+    ~DispatchWorkerPool();
+
+    // Delete copy
+    DispatchWorkerPool(const DispatchWorkerPool&) = delete;
+    DispatchWorkerPool& operator=(const DispatchWorkerPool&) = delete;
+
+    // Submission
+    bool submit(std::unique_ptr<Event> event);
+    bool submit(std::unique_ptr<Event> event, EventTypeId route);
+    bool try_submit(std::unique_ptr<Event>& event);
+    bool try_submit(std::unique_ptr<Event>& event, EventTypeId route);
+
+    // Lifecycle
+    void drain();
+    void shutdown(bool drain_pending = true);
+
+    // Query
+    size_t thread_count() const;
+    size_t pending() const;
+    bool running() const;
+
+private:
+    struct Lane {
+        explicit Lane(const QueueConfig& config) : queue(config), sleeping(false) {}
+
+        EventQueue queue;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::atomic<bool> sleeping;
+    };
+
+    void worker_loop(Lane& lane);
+    void wake(Lane& lane);
+    bool is_idle() const;
+    void notify_if_idle();
+
+    DispatchFunc dispatch_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> stopping_;
+    std::atomic<size_t> submitted_;
+    std::atomic<size_t> processed_;
+    std::mutex idle_mutex_;
+    std::condition_variable idle_;
+};
+
+/**
+ * @brief Fork-join pool that runs the tasks of one call concurrently
+ *
+ * run(count, func) calls func(0) .. func(count - 1) on the worker threads
+ * and the calling thread, which claims tasks too, and returns once all of
+ * them finished. The first exception thrown by a task is rethrown from run
+ * after the rest completed. One call fans out at a time: a run issued while
+ * another is in progress, including one from inside a task, executes its
+ * tasks inline on the calling thread.
+ */
+class FanOutPool {
+public:
+    explicit FanOutPool(size_t thread_count);
+    ~FanOutPool();
+
+    // Delete copy
+    FanOutPool(const FanOutPool&) = delete;
+    FanOutPool& operator=(const FanOutPool&) = delete;
+
+    template <typename Func>
+    void run(size_t count, Func& func) {
+        run_tasks(count, [](void* context, size_t index) { (*static_cast<Func*>(context))(index); }, &func);
+    }
+
+    size_t thread_count() const;
+
+private:
+    using Invoke = void (*)(void*, size_t);
+
+    struct Job {
+        Invoke invoke;
+        void* context;
+        size_t count;
+        std::atomic<size_t> next{0};
+        size_t participants = 0;  // Workers inside the job; guarded by the pool mutex
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    void run_tasks(size_t count, Invoke invoke, void* context);
+    void work(Job& job);
+    void worker_loop();
+
+    std::vector<std::thread> threads_;
+    std::mutex run_mutex_;  // Held by the fanning-out caller
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable job_left_;
+    Job* job_;
+    uint64_t generation_;
+    bool stopping_;
+};
+
+}  // namespace temp2::events
+
+#endif  // TEMP2_EVENTS_WORKER_POOL_HPP
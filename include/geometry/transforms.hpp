@@ -4,6 +4,7 @@
 #include "point.hpp"
 #include "vector2d.hpp"
 #include <array>
+#include <vector>
 
 namespace temp2::geometry {
 
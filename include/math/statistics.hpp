@@ -1,6 +1,7 @@
 #ifndef TEMP2_MATH_STATISTICS_HPP
 #define TEMP2_MATH_STATISTICS_HPP
 
+#include <cstddef>
 #include <vector>
 #include <utility>
 
@@ -100,6 +100,38 @@ void demo_containers() {
     }
     std::cout << "\n";
 
+    // Iterators taken before push_back/push_front stay usable
+    temp2::containers::SinglyLinkedList<int> singly;
+    temp2::containers::SinglyLinkedList<int> other;
+    singly.push_back(1);
+    other.push_back(3);
+    auto end = singly.end();
+    singly.push_back(2);
+    singly.splice(end, other);
+    auto first = singly.begin();
+    singly.push_front(0);
+    singly.erase(first);
+    std::cout << "SinglyLinkedList after splice and erase: ";
+    for (int value : singly) std::cout << value << " ";
+    std::cout << "(size " << singly.size() << ", back " << singly.back() << ")\n";
+
+    // A list sharing a pool that is merged into a third list keeps its nodes
+    temp2::containers::SinglyLinkedList<int> survivor;
+    {
+        temp2::containers::SinglyLinkedList<int> a;
+        temp2::containers::SinglyLinkedList<int> c;
+        a.push_back(1);
+        c.push_back(2);
+        survivor.push_back(3);
+        c.splice(c.end(), survivor);
+        survivor.push_back(4);
+        a.splice(a.end(), c);
+    }
+    survivor.push_back(5);
+    std::cout << "SinglyLinkedList after its pool was merged away: ";
+    for (int value : survivor) std::cout << value << " ";
+    std::cout << "\n";
+
     // Stack
     temp2::containers::ArrayStack<int> stack;
     stack.push(10);
@@ -1,37 +1,145 @@
 #include "containers/linked_list.hpp"
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace temp2::containers {
 
+namespace {
+
+// Merge two sorted chains; ties take the left one, which keeps sorts stable
+template <typename Node, typename Compare>
+Node* merge_chains(Node* left, Node* right, const Compare& less) {
+    Node* head = nullptr;
+    Node** link = &head;
+    while (left && right) {
+        if (less(right->data, left->data)) {
+            *link = right;
+            right = right->next;
+        } else {
+            *link = left;
+            left = left->next;
+        }
+        link = &(*link)->next;
+    }
+    *link = left ? left : right;
+    return head;
+}
+
+// Bottom-up merge sort over the next links, returning the new head. Nodes
+// are fed one at a time into a binary counter of runs: runs[i] is empty or
+// holds 2^i sorted nodes that all precede the nodes in lower slots. This
+// needs no recursion and a fixed number of run heads, and merges runs while
+// their nodes are still in cache.
+template <typename Node, typename Compare>
+Node* merge_sort_chain(Node* head, const Compare& less) {
+    constexpr size_t MAX_RUNS = 64;
+    Node* runs[MAX_RUNS] = {};
+    size_t used = 0;
+
+    while (head) {
+        Node* carry = head;
+        head = head->next;
+        carry->next = nullptr;
+
+        size_t i = 0;
+        for (; i < used && runs[i]; ++i) {
+            carry = merge_chains(runs[i], carry, less);
+            runs[i] = nullptr;
+        }
+        if (i == used) {
+            ++used;
+        }
+        runs[i] = carry;
+    }
+
+    Node* result = nullptr;
+    for (size_t i = 0; i < used; ++i) {
+        if (runs[i]) {
+            result = merge_chains(runs[i], result, less);
+        }
+    }
+    return result;
+}
+
+// Random-access iterator over the elements of packed unrolled nodes: every
+// node in the table except the last holds exactly Node::CAPACITY elements,
+// so element i lives in table[i / CAPACITY] at offset i % CAPACITY
+template <typename Node, typename T>
+class PackedNodeIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    PackedNodeIterator() : table_(nullptr), index_(0) {}
+    PackedNodeIterator(Node* const* table, size_t index) : table_(table), index_(index) {}
+
+    reference operator*() const { return table_[index_ / Node::CAPACITY]->items()[index_ % Node::CAPACITY]; }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    PackedNodeIterator& operator++() { ++index_; return *this; }
+    PackedNodeIterator operator++(int) { PackedNodeIterator old = *this; ++index_; return old; }
+    PackedNodeIterator& operator--() { --index_; return *this; }
+    PackedNodeIterator operator--(int) { PackedNodeIterator old = *this; --index_; return old; }
+    PackedNodeIterator& operator+=(difference_type n) { index_ += static_cast<size_t>(n); return *this; }
+    PackedNodeIterator& operator-=(difference_type n) { index_ -= static_cast<size_t>(n); return *this; }
+
+    friend PackedNodeIterator operator+(PackedNodeIterator it, difference_type n) { return it += n; }
+    friend PackedNodeIterator operator+(difference_type n, PackedNodeIterator it) { return it += n; }
+    friend PackedNodeIterator operator-(PackedNodeIterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const PackedNodeIterator& a, const PackedNodeIterator& b) {
+        return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const PackedNodeIterator& a, const PackedNodeIterator& b) { return a.index_ == b.index_; }
+    friend auto operator<=>(const PackedNodeIterator& a, const PackedNodeIterator& b) { return a.index_ <=> b.index_; }
+
+private:
+    Node* const* table_;
+    size_t index_;
+};
+
+}  // namespace
+
 // =============================================================================
 // SinglyLinkedList
 // =============================================================================
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList() : head_(nullptr), tail_(nullptr), size_(0) {}
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList()
+    : head_(nullptr), tail_(nullptr), size_(0), cursor_node_(nullptr), cursor_index_(0) {}
 
-template <typename T>
-SinglyLinkedList<T>::~SinglyLinkedList() {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::~SinglyLinkedList() {
     clear();
 }
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList& other)
-    : head_(nullptr), tail_(nullptr), size_(0) {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(const SinglyLinkedList& other)
+    : head_(nullptr), tail_(nullptr), size_(0),
+      alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)),
+      cursor_node_(nullptr), cursor_index_(0) {
     copy_from(other);
 }
 
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList(SinglyLinkedList&& other) noexcept
-    : head_(other.head_), tail_(other.tail_), size_(other.size_) {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(SinglyLinkedList&& other) noexcept
+    : head_(other.head_), tail_(other.tail_), size_(other.size_), alloc_(std::move(other.alloc_)),
+      cursor_node_(nullptr), cursor_index_(0) {
     other.head_ = nullptr;
     other.tail_ = nullptr;
     other.size_ = 0;
+    other.reset_cursor();
 }
 
-template <typename T>
-SinglyLinkedList<T>& SinglyLinkedList<T>::operator=(const SinglyLinkedList& other) {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>& SinglyLinkedList<T, Allocator>::operator=(const SinglyLinkedList& other) {
     if (this != &other) {
         clear();
         copy_from(other);
@@ -39,43 +147,116 @@ SinglyLinkedList<T>& SinglyLinkedList<T>::operator=(const SinglyLinkedList& othe
     return *this;
 }
 
-template <typename T>
-SinglyLinkedList<T>& SinglyLinkedList<T>::operator=(SinglyLinkedList&& other) noexcept {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>& SinglyLinkedList<T, Allocator>::operator=(SinglyLinkedList&& other) noexcept {
     if (this != &other) {
         clear();
+        // Nodes can only change hands together with the allocator that owns them
+        static_assert(NodeTraits::propagate_on_container_move_assignment::value,
+                      "Node allocator must propagate on move assignment");
+        alloc_ = std::move(other.alloc_);
         head_ = other.head_;
         tail_ = other.tail_;
         size_ = other.size_;
         other.head_ = nullptr;
         other.tail_ = nullptr;
         other.size_ = 0;
+        other.reset_cursor();
     }
     return *this;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::copy_from(const SinglyLinkedList& other) {
-    SListNode<T>* current = other.head_;
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::copy_from(const SinglyLinkedList& other) {
+    Node* current = other.head_;
     while (current) {
         push_back(current->data);
         current = current->next;
     }
 }
 
-template <typename T>
-void SinglyLinkedList<T>::push_front(const T& value) {
-    SListNode<T>* node = new SListNode<T>(value);
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Node* SinglyLinkedList<T, Allocator>::create_node(const T& value) {
+    Node* node = NodeTraits::allocate(alloc_, 1);
+    try {
+        NodeTraits::construct(alloc_, node, value);
+    } catch (...) {
+        NodeTraits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::destroy_node(Node* node) {
+    NodeTraits::destroy(alloc_, node);
+    NodeTraits::deallocate(alloc_, node, 1);
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Node* SinglyLinkedList<T, Allocator>::seek(size_t index) const {
+    if (index == size_ - 1) {
+        return tail_;
+    }
+
+    Node* current = head_;
+    size_t position = 0;
+    if (cursor_node_ && cursor_index_ <= index) {
+        current = cursor_node_;
+        position = cursor_index_;
+    }
+    for (; position < index; ++position) {
+        current = current->next;
+    }
+    return current;
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::reset_cursor() {
+    cursor_node_ = nullptr;
+    cursor_index_ = 0;
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Node* SinglyLinkedList<T, Allocator>::predecessor(const_iterator pos) const {
+    if (!pos.node_) return tail_;
+    if (pos.node_ == head_) return nullptr;
+    if (pos.prev_ && pos.prev_->next == pos.node_) return pos.prev_;
+
+    // Something was inserted in front of pos since the iterator was taken
+    Node* prev = head_;
+    while (prev->next != pos.node_) {
+        prev = prev->next;
+    }
+    return prev;
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::share_allocator(SinglyLinkedList& other) {
+    if constexpr (requires(NodeAllocator& a, NodeAllocator& b) { a.merge(b); }) {
+        alloc_.merge(other.alloc_);
+    } else {
+        static_assert(NodeTraits::is_always_equal::value, "splice needs interchangeable node allocators");
+    }
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::push_front(const T& value) {
+    Node* node = create_node(value);
     node->next = head_;
     head_ = node;
     if (!tail_) {
         tail_ = node;
     }
     ++size_;
+    if (cursor_node_) {
+        ++cursor_index_;
+    }
 }
 
-template <typename T>
-void SinglyLinkedList<T>::push_back(const T& value) {
-    SListNode<T>* node = new SListNode<T>(value);
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::push_back(const T& value) {
+    Node* node = create_node(value);
     if (tail_) {
         tail_->next = node;
     } else {
@@ -85,8 +266,8 @@ void SinglyLinkedList<T>::push_back(const T& value) {
     ++size_;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::insert_at(size_t index, const T& value) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::insert_at(size_t index, const T& value) {
     if (index > size_) {
         throw std::out_of_range("Index out of range");
     }
@@ -101,59 +282,65 @@ void SinglyLinkedList<T>::insert_at(size_t index, const T& value) {
         return;
     }
 
-    SListNode<T>* prev = head_;
-    for (size_t i = 0; i < index - 1; ++i) {
-        prev = prev->next;
-    }
+    Node* prev = seek(index - 1);
 
-    SListNode<T>* node = new SListNode<T>(value);
+    Node* node = create_node(value);
     node->next = prev->next;
     prev->next = node;
     ++size_;
+
+    cursor_node_ = prev;
+    cursor_index_ = index - 1;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::pop_front() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::pop_front() {
     if (empty()) {
         throw std::runtime_error("Pop from empty list");
     }
 
-    SListNode<T>* node = head_;
+    Node* node = head_;
     head_ = head_->next;
     if (!head_) {
         tail_ = nullptr;
     }
-    delete node;
+    if (cursor_node_ == node) {
+        reset_cursor();
+    } else if (cursor_node_) {
+        --cursor_index_;
+    }
+    destroy_node(node);
     --size_;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::pop_back() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::pop_back() {
     if (empty()) {
         throw std::runtime_error("Pop from empty list");
     }
 
+    if (cursor_node_ == tail_) {
+        reset_cursor();
+    }
+
     if (size_ == 1) {
-        delete head_;
+        destroy_node(head_);
         head_ = nullptr;
         tail_ = nullptr;
         size_ = 0;
         return;
     }
 
-    SListNode<T>* prev = head_;
-    while (prev->next != tail_) {
-        prev = prev->next;
-    }
+    Node* prev = seek(size_ - 2);
 
-    delete tail_;
+    destroy_node(tail_);
     tail_ = prev;
     tail_->next = nullptr;
     --size_;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::remove_at(size_t index) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::remove_at(size_t index) {
     if (index >= size_) {
         throw std::out_of_range("Index out of range");
     }
@@ -163,26 +350,26 @@ void SinglyLinkedList<T>::remove_at(size_t index) {
         return;
     }
 
-    SListNode<T>* prev = head_;
-    for (size_t i = 0; i < index - 1; ++i) {
-        prev = prev->next;
-    }
+    Node* prev = seek(index - 1);
 
-    SListNode<T>* node = prev->next;
+    Node* node = prev->next;
     prev->next = node->next;
 
     if (node == tail_) {
         tail_ = prev;
     }
 
-    delete node;
+    destroy_node(node);
     --size_;
+
+    cursor_node_ = prev;
+    cursor_index_ = index - 1;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::remove_value(const T& value) {
-    SListNode<T>* prev = nullptr;
-    SListNode<T>* current = head_;
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::remove_value(const T& value) {
+    Node* prev = nullptr;
+    Node* current = head_;
 
     while (current) {
         if (current->data == value) {
@@ -196,7 +383,8 @@ void SinglyLinkedList<T>::remove_value(const T& value) {
                 tail_ = prev;
             }
 
-            delete current;
+            reset_cursor();
+            destroy_node(current);
             --size_;
             return;
         }
@@ -205,66 +393,175 @@ void SinglyLinkedList<T>::remove_value(const T& value) {
     }
 }
 
-template <typename T>
-void SinglyLinkedList<T>::clear() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::clear() {
     while (head_) {
-        SListNode<T>* node = head_;
+        Node* node = head_;
         head_ = head_->next;
-        delete node;
+        destroy_node(node);
     }
     tail_ = nullptr;
     size_ = 0;
+    reset_cursor();
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::reserve(size_t count) {
+    if (count <= size_) return;
+    if constexpr (requires(NodeAllocator& alloc) { alloc.reserve(count); }) {
+        alloc_.reserve(count - size_);
+    }
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::iterator SinglyLinkedList<T, Allocator>::insert_after(const_iterator pos,
+                                                                                              const T& value) {
+    if (!pos.node_) {
+        throw std::out_of_range("Cannot insert after end");
+    }
+
+    Node* node = create_node(value);
+    node->next = pos.node_->next;
+    pos.node_->next = node;
+    if (pos.node_ == tail_) {
+        tail_ = node;
+    }
+    ++size_;
+    reset_cursor();
+    return iterator(pos.node_, node);
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::iterator SinglyLinkedList<T, Allocator>::erase(const_iterator pos) {
+    if (!pos.node_) {
+        throw std::out_of_range("Cannot erase end");
+    }
+
+    Node* node = pos.node_;
+    Node* prev = predecessor(pos);
+    Node* next = node->next;
+    if (prev) {
+        prev->next = next;
+    } else {
+        head_ = next;
+    }
+    if (node == tail_) {
+        tail_ = prev;
+    }
+
+    reset_cursor();
+    destroy_node(node);
+    --size_;
+    return iterator(prev, next);
 }
 
-template <typename T>
-T& SinglyLinkedList<T>::front() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::splice(const_iterator pos, SinglyLinkedList& other) {
+    if (&other == this || other.empty()) return;
+
+    share_allocator(other);
+
+    // Link other's chain between pos's predecessor and pos
+    if (Node* prev = predecessor(pos)) {
+        prev->next = other.head_;
+    } else {
+        head_ = other.head_;
+    }
+    other.tail_->next = pos.node_;
+    if (!pos.node_) {
+        tail_ = other.tail_;
+    }
+    size_ += other.size_;
+
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.size_ = 0;
+    other.reset_cursor();
+    reset_cursor();
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::splice(const_iterator pos, SinglyLinkedList& other, const_iterator it) {
+    if (!it.node_) {
+        throw std::out_of_range("Cannot splice end");
+    }
+    Node* node = it.node_;
+    Node* pos_prev = predecessor(pos);
+    if (&other == this && (pos.node_ == node || pos_prev == node)) return;
+
+    share_allocator(other);
+
+    Node* it_prev = other.predecessor(it);
+    if (it_prev) {
+        it_prev->next = node->next;
+    } else {
+        other.head_ = node->next;
+    }
+    if (node == other.tail_) {
+        other.tail_ = it_prev;
+    }
+    --other.size_;
+
+    // pos_prev still precedes pos: it is not node, and within one list it
+    // can only be node's predecessor if pos and it are the same position
+    node->next = pos.node_;
+    if (pos_prev) {
+        pos_prev->next = node;
+    } else {
+        head_ = node;
+    }
+    if (!pos.node_) {
+        tail_ = node;
+    }
+    ++size_;
+
+    other.reset_cursor();
+    reset_cursor();
+}
+
+template <typename T, typename Allocator>
+T& SinglyLinkedList<T, Allocator>::front() {
     if (empty()) throw std::runtime_error("Empty list");
     return head_->data;
 }
 
-template <typename T>
-const T& SinglyLinkedList<T>::front() const {
+template <typename T, typename Allocator>
+const T& SinglyLinkedList<T, Allocator>::front() const {
     if (empty()) throw std::runtime_error("Empty list");
     return head_->data;
 }
 
-template <typename T>
-T& SinglyLinkedList<T>::back() {
+template <typename T, typename Allocator>
+T& SinglyLinkedList<T, Allocator>::back() {
     if (empty()) throw std::runtime_error("Empty list");
     return tail_->data;
 }
 
-template <typename T>
-const T& SinglyLinkedList<T>::back() const {
+template <typename T, typename Allocator>
+const T& SinglyLinkedList<T, Allocator>::back() const {
     if (empty()) throw std::runtime_error("Empty list");
     return tail_->data;
 }
 
-template <typename T>
-T& SinglyLinkedList<T>::at(size_t index) {
+template <typename T, typename Allocator>
+T& SinglyLinkedList<T, Allocator>::at(size_t index) {
     if (index >= size_) throw std::out_of_range("Index out of range");
 
-    SListNode<T>* current = head_;
-    for (size_t i = 0; i < index; ++i) {
-        current = current->next;
-    }
+    Node* current = seek(index);
+    cursor_node_ = current;
+    cursor_index_ = index;
     return current->data;
 }
 
-template <typename T>
-const T& SinglyLinkedList<T>::at(size_t index) const {
+template <typename T, typename Allocator>
+const T& SinglyLinkedList<T, Allocator>::at(size_t index) const {
     if (index >= size_) throw std::out_of_range("Index out of range");
-
-    SListNode<T>* current = head_;
-    for (size_t i = 0; i < index; ++i) {
-        current = current->next;
-    }
-    return current->data;
+    return seek(index)->data;
 }
 
-template <typename T>
-std::optional<T> SinglyLinkedList<T>::find(const T& value) const {
-    SListNode<T>* current = head_;
+template <typename T, typename Allocator>
+std::optional<T> SinglyLinkedList<T, Allocator>::find(const T& value) const {
+    Node* current = head_;
     while (current) {
         if (current->data == value) {
             return current->data;
@@ -274,25 +571,25 @@ std::optional<T> SinglyLinkedList<T>::find(const T& value) const {
     return std::nullopt;
 }
 
-template <typename T>
-size_t SinglyLinkedList<T>::size() const {
+template <typename T, typename Allocator>
+size_t SinglyLinkedList<T, Allocator>::size() const {
     return size_;
 }
 
-template <typename T>
-bool SinglyLinkedList<T>::empty() const {
+template <typename T, typename Allocator>
+bool SinglyLinkedList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-bool SinglyLinkedList<T>::contains(const T& value) const {
+template <typename T, typename Allocator>
+bool SinglyLinkedList<T, Allocator>::contains(const T& value) const {
     return find(value).has_value();
 }
 
-template <typename T>
-size_t SinglyLinkedList<T>::count(const T& value) const {
+template <typename T, typename Allocator>
+size_t SinglyLinkedList<T, Allocator>::count(const T& value) const {
     size_t cnt = 0;
-    SListNode<T>* current = head_;
+    Node* current = head_;
     while (current) {
         if (current->data == value) {
             ++cnt;
@@ -302,41 +599,52 @@ size_t SinglyLinkedList<T>::count(const T& value) const {
     return cnt;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::reverse() {
-    SListNode<T>* prev = nullptr;
-    SListNode<T>* current = head_;
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::reverse() {
+    Node* prev = nullptr;
+    Node* current = head_;
     tail_ = head_;
 
     while (current) {
-        SListNode<T>* next = current->next;
+        Node* next = current->next;
         current->next = prev;
         prev = current;
         current = next;
     }
 
     head_ = prev;
+    reset_cursor();
 }
 
-template <typename T>
-void SinglyLinkedList<T>::sort() {
+template <typename T, typename Allocator>
+template <typename Compare>
+void SinglyLinkedList<T, Allocator>::merge_sort(const Compare& less) {
     if (size_ <= 1) return;
 
-    std::vector<T> vec = to_vector();
-    std::sort(vec.begin(), vec.end());
-
-    clear();
-    for (const T& val : vec) {
-        push_back(val);
+    head_ = merge_sort_chain(head_, less);
+    tail_ = head_;
+    while (tail_->next) {
+        tail_ = tail_->next;
     }
+    reset_cursor();
+}
+
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::sort() {
+    merge_sort(std::less<T>());
 }
 
-template <typename T>
-std::vector<T> SinglyLinkedList<T>::to_vector() const {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::sort(const std::function<bool(const T&, const T&)>& less) {
+    merge_sort(less);
+}
+
+template <typename T, typename Allocator>
+std::vector<T> SinglyLinkedList<T, Allocator>::to_vector() const {
     std::vector<T> result;
     result.reserve(size_);
 
-    SListNode<T>* current = head_;
+    Node* current = head_;
     while (current) {
         result.push_back(current->data);
         current = current->next;
@@ -345,52 +653,87 @@ std::vector<T> SinglyLinkedList<T>::to_vector() const {
     return result;
 }
 
-template <typename T>
-void SinglyLinkedList<T>::for_each(const std::function<void(T&)>& fn) {
-    SListNode<T>* current = head_;
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::for_each(const std::function<void(T&)>& fn) {
+    Node* current = head_;
     while (current) {
         fn(current->data);
         current = current->next;
     }
 }
 
-template <typename T>
-void SinglyLinkedList<T>::for_each(const std::function<void(const T&)>& fn) const {
-    SListNode<T>* current = head_;
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::for_each(const std::function<void(const T&)>& fn) const {
+    Node* current = head_;
     while (current) {
         fn(current->data);
         current = current->next;
     }
 }
 
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::iterator SinglyLinkedList<T, Allocator>::begin() {
+    return iterator(nullptr, head_);
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::iterator SinglyLinkedList<T, Allocator>::end() {
+    return iterator(nullptr, nullptr);
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::const_iterator SinglyLinkedList<T, Allocator>::begin() const {
+    return const_iterator(nullptr, head_);
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::const_iterator SinglyLinkedList<T, Allocator>::end() const {
+    return const_iterator(nullptr, nullptr);
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::const_iterator SinglyLinkedList<T, Allocator>::cbegin() const {
+    return begin();
+}
+
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::const_iterator SinglyLinkedList<T, Allocator>::cend() const {
+    return end();
+}
+
 // =============================================================================
 // DoublyLinkedList
 // =============================================================================
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList() : head_(nullptr), tail_(nullptr), size_(0) {}
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList()
+    : head_(nullptr), tail_(nullptr), size_(0), cursor_node_(nullptr), cursor_index_(0) {}
 
-template <typename T>
-DoublyLinkedList<T>::~DoublyLinkedList() {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
     clear();
 }
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(const DoublyLinkedList& other)
-    : head_(nullptr), tail_(nullptr), size_(0) {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(const DoublyLinkedList& other)
+    : head_(nullptr), tail_(nullptr), size_(0),
+      alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)),
+      cursor_node_(nullptr), cursor_index_(0) {
     copy_from(other);
 }
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList&& other) noexcept
-    : head_(other.head_), tail_(other.tail_), size_(other.size_) {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(DoublyLinkedList&& other) noexcept
+    : head_(other.head_), tail_(other.tail_), size_(other.size_), alloc_(std::move(other.alloc_)),
+      cursor_node_(nullptr), cursor_index_(0) {
     other.head_ = nullptr;
     other.tail_ = nullptr;
     other.size_ = 0;
+    other.reset_cursor();
 }
 
-template <typename T>
-DoublyLinkedList<T>& DoublyLinkedList<T>::operator=(const DoublyLinkedList& other) {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>& DoublyLinkedList<T, Allocator>::operator=(const DoublyLinkedList& other) {
     if (this != &other) {
         clear();
         copy_from(other);
@@ -398,32 +741,116 @@ DoublyLinkedList<T>& DoublyLinkedList<T>::operator=(const DoublyLinkedList& othe
     return *this;
 }
 
-template <typename T>
-DoublyLinkedList<T>& DoublyLinkedList<T>::operator=(DoublyLinkedList&& other) noexcept {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>& DoublyLinkedList<T, Allocator>::operator=(DoublyLinkedList&& other) noexcept {
     if (this != &other) {
         clear();
+        static_assert(NodeTraits::propagate_on_container_move_assignment::value,
+                      "Node allocator must propagate on move assignment");
+        alloc_ = std::move(other.alloc_);
         head_ = other.head_;
         tail_ = other.tail_;
         size_ = other.size_;
         other.head_ = nullptr;
         other.tail_ = nullptr;
         other.size_ = 0;
+        other.reset_cursor();
     }
     return *this;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::copy_from(const DoublyLinkedList& other) {
-    DListNode<T>* current = other.head_;
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::copy_from(const DoublyLinkedList& other) {
+    Node* current = other.head_;
     while (current) {
         push_back(current->data);
         current = current->next;
     }
 }
 
-template <typename T>
-void DoublyLinkedList<T>::push_front(const T& value) {
-    DListNode<T>* node = new DListNode<T>(value);
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Node* DoublyLinkedList<T, Allocator>::create_node(const T& value) {
+    Node* node = NodeTraits::allocate(alloc_, 1);
+    try {
+        NodeTraits::construct(alloc_, node, value);
+    } catch (...) {
+        NodeTraits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::destroy_node(Node* node) {
+    NodeTraits::destroy(alloc_, node);
+    NodeTraits::deallocate(alloc_, node, 1);
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Node* DoublyLinkedList<T, Allocator>::seek(size_t index) const {
+    // Start from whichever of head, tail and cursor is closest
+    Node* current = head_;
+    size_t position = 0;
+    size_t distance = index;
+
+    if (size_ - 1 - index < distance) {
+        current = tail_;
+        position = size_ - 1;
+        distance = size_ - 1 - index;
+    }
+    if (cursor_node_) {
+        size_t from_cursor = cursor_index_ > index ? cursor_index_ - index : index - cursor_index_;
+        if (from_cursor < distance) {
+            current = cursor_node_;
+            position = cursor_index_;
+        }
+    }
+
+    for (; position < index; ++position) {
+        current = current->next;
+    }
+    for (; position > index; --position) {
+        current = current->prev;
+    }
+    return current;
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::reset_cursor() {
+    cursor_node_ = nullptr;
+    cursor_index_ = 0;
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::share_allocator(DoublyLinkedList& other) {
+    if constexpr (requires(NodeAllocator& a, NodeAllocator& b) { a.merge(b); }) {
+        alloc_.merge(other.alloc_);
+    } else {
+        static_assert(NodeTraits::is_always_equal::value, "splice needs interchangeable node allocators");
+    }
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::link_before(Node* pos, Node* first, Node* last) {
+    Node* prev = pos ? pos->prev : tail_;
+    first->prev = prev;
+    last->next = pos;
+
+    if (prev) {
+        prev->next = first;
+    } else {
+        head_ = first;
+    }
+    if (pos) {
+        pos->prev = last;
+    } else {
+        tail_ = last;
+    }
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::push_front(const T& value) {
+    Node* node = create_node(value);
     node->next = head_;
 
     if (head_) {
@@ -434,11 +861,14 @@ void DoublyLinkedList<T>::push_front(const T& value) {
 
     head_ = node;
     ++size_;
+    if (cursor_node_) {
+        ++cursor_index_;
+    }
 }
 
-template <typename T>
-void DoublyLinkedList<T>::push_back(const T& value) {
-    DListNode<T>* node = new DListNode<T>(value);
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::push_back(const T& value) {
+    Node* node = create_node(value);
     node->prev = tail_;
 
     if (tail_) {
@@ -451,8 +881,8 @@ void DoublyLinkedList<T>::push_back(const T& value) {
     ++size_;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::insert_at(size_t index, const T& value) {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::insert_at(size_t index, const T& value) {
     if (index > size_) {
         throw std::out_of_range("Index out of range");
     }
@@ -467,32 +897,24 @@ void DoublyLinkedList<T>::insert_at(size_t index, const T& value) {
         return;
     }
 
-    DListNode<T>* current;
-    if (index < size_ / 2) {
-        current = head_;
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next;
-        }
-    } else {
-        current = tail_;
-        for (size_t i = size_ - 1; i > index; --i) {
-            current = current->prev;
-        }
-    }
+    Node* current = seek(index);
 
-    DListNode<T>* node = new DListNode<T>(value);
+    Node* node = create_node(value);
     node->prev = current->prev;
     node->next = current;
     current->prev->next = node;
     current->prev = node;
     ++size_;
+
+    cursor_node_ = node;
+    cursor_index_ = index;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::pop_front() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::pop_front() {
     if (empty()) throw std::runtime_error("Pop from empty list");
 
-    DListNode<T>* node = head_;
+    Node* node = head_;
     head_ = head_->next;
 
     if (head_) {
@@ -501,15 +923,20 @@ void DoublyLinkedList<T>::pop_front() {
         tail_ = nullptr;
     }
 
-    delete node;
+    if (cursor_node_ == node) {
+        reset_cursor();
+    } else if (cursor_node_) {
+        --cursor_index_;
+    }
+    destroy_node(node);
     --size_;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::pop_back() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::pop_back() {
     if (empty()) throw std::runtime_error("Pop from empty list");
 
-    DListNode<T>* node = tail_;
+    Node* node = tail_;
     tail_ = tail_->prev;
 
     if (tail_) {
@@ -518,12 +945,15 @@ void DoublyLinkedList<T>::pop_back() {
         head_ = nullptr;
     }
 
-    delete node;
+    if (cursor_node_ == node) {
+        reset_cursor();
+    }
+    destroy_node(node);
     --size_;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::remove_at(size_t index) {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::remove_at(size_t index) {
     if (index >= size_) throw std::out_of_range("Index out of range");
 
     if (index == 0) {
@@ -536,125 +966,213 @@ void DoublyLinkedList<T>::remove_at(size_t index) {
         return;
     }
 
-    DListNode<T>* current;
-    if (index < size_ / 2) {
-        current = head_;
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next;
-        }
-    } else {
-        current = tail_;
-        for (size_t i = size_ - 1; i > index; --i) {
-            current = current->prev;
-        }
-    }
+    Node* current = seek(index);
 
     current->prev->next = current->next;
     current->next->prev = current->prev;
-    delete current;
+    cursor_node_ = current->prev;
+    cursor_index_ = index - 1;
+    destroy_node(current);
     --size_;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::clear() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::clear() {
     while (head_) {
-        DListNode<T>* node = head_;
+        Node* node = head_;
         head_ = head_->next;
-        delete node;
+        destroy_node(node);
     }
     tail_ = nullptr;
     size_ = 0;
+    reset_cursor();
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::reserve(size_t count) {
+    if (count <= size_) return;
+    if constexpr (requires(NodeAllocator& alloc) { alloc.reserve(count); }) {
+        alloc_.reserve(count - size_);
+    }
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::iterator DoublyLinkedList<T, Allocator>::insert_after(const_iterator pos,
+                                                                                              const T& value) {
+    if (!pos.node_) {
+        throw std::out_of_range("Cannot insert after end");
+    }
+
+    Node* node = create_node(value);
+    link_before(pos.node_->next, node, node);
+    ++size_;
+    reset_cursor();
+    return iterator(node, this);
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::iterator DoublyLinkedList<T, Allocator>::erase(const_iterator pos) {
+    if (!pos.node_) {
+        throw std::out_of_range("Cannot erase end");
+    }
+
+    Node* node = pos.node_;
+    Node* next = node->next;
+    if (node->prev) {
+        node->prev->next = next;
+    } else {
+        head_ = next;
+    }
+    if (next) {
+        next->prev = node->prev;
+    } else {
+        tail_ = node->prev;
+    }
+
+    reset_cursor();
+    destroy_node(node);
+    --size_;
+    return iterator(next, this);
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::splice(const_iterator pos, DoublyLinkedList& other) {
+    if (&other == this || other.empty()) return;
+
+    share_allocator(other);
+    link_before(pos.node_, other.head_, other.tail_);
+    size_ += other.size_;
+
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.size_ = 0;
+    other.reset_cursor();
+    reset_cursor();
 }
 
-template <typename T>
-T& DoublyLinkedList<T>::front() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::splice(const_iterator pos, DoublyLinkedList& other, const_iterator it) {
+    if (!it.node_) {
+        throw std::out_of_range("Cannot splice end");
+    }
+    Node* node = it.node_;
+    if (&other == this && (pos.node_ == node || pos.node_ == node->next)) return;
+
+    share_allocator(other);
+
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        other.head_ = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        other.tail_ = node->prev;
+    }
+    --other.size_;
+
+    link_before(pos.node_, node, node);
+    ++size_;
+
+    other.reset_cursor();
+    reset_cursor();
+}
+
+template <typename T, typename Allocator>
+T& DoublyLinkedList<T, Allocator>::front() {
     if (empty()) throw std::runtime_error("Empty list");
     return head_->data;
 }
 
-template <typename T>
-const T& DoublyLinkedList<T>::front() const {
+template <typename T, typename Allocator>
+const T& DoublyLinkedList<T, Allocator>::front() const {
     if (empty()) throw std::runtime_error("Empty list");
     return head_->data;
 }
 
-template <typename T>
-T& DoublyLinkedList<T>::back() {
+template <typename T, typename Allocator>
+T& DoublyLinkedList<T, Allocator>::back() {
     if (empty()) throw std::runtime_error("Empty list");
     return tail_->data;
 }
 
-template <typename T>
-const T& DoublyLinkedList<T>::back() const {
+template <typename T, typename Allocator>
+const T& DoublyLinkedList<T, Allocator>::back() const {
     if (empty()) throw std::runtime_error("Empty list");
     return tail_->data;
 }
 
-template <typename T>
-T& DoublyLinkedList<T>::at(size_t index) {
+template <typename T, typename Allocator>
+T& DoublyLinkedList<T, Allocator>::at(size_t index) {
     if (index >= size_) throw std::out_of_range("Index out of range");
 
-    DListNode<T>* current;
-    if (index < size_ / 2) {
-        current = head_;
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next;
-        }
-    } else {
-        current = tail_;
-        for (size_t i = size_ - 1; i > index; --i) {
-            current = current->prev;
-        }
-    }
+    Node* current = seek(index);
+    cursor_node_ = current;
+    cursor_index_ = index;
     return current->data;
 }
 
-template <typename T>
-const T& DoublyLinkedList<T>::at(size_t index) const {
+template <typename T, typename Allocator>
+const T& DoublyLinkedList<T, Allocator>::at(size_t index) const {
     if (index >= size_) throw std::out_of_range("Index out of range");
-
-    DListNode<T>* current;
-    if (index < size_ / 2) {
-        current = head_;
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next;
-        }
-    } else {
-        current = tail_;
-        for (size_t i = size_ - 1; i > index; --i) {
-            current = current->prev;
-        }
-    }
-    return current->data;
+    return seek(index)->data;
 }
 
-template <typename T>
-size_t DoublyLinkedList<T>::size() const {
+template <typename T, typename Allocator>
+size_t DoublyLinkedList<T, Allocator>::size() const {
     return size_;
 }
 
-template <typename T>
-bool DoublyLinkedList<T>::empty() const {
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::empty() const {
     return size_ == 0;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::reverse() {
-    DListNode<T>* current = head_;
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::reverse() {
+    Node* current = head_;
     std::swap(head_, tail_);
 
     while (current) {
         std::swap(current->prev, current->next);
         current = current->prev;
     }
+    reset_cursor();
 }
 
-template <typename T>
-std::vector<T> DoublyLinkedList<T>::to_vector() const {
+template <typename T, typename Allocator>
+template <typename Compare>
+void DoublyLinkedList<T, Allocator>::merge_sort(const Compare& less) {
+    if (size_ <= 1) return;
+
+    // Sort along the next links, then rebuild the prev links in one pass
+    head_ = merge_sort_chain(head_, less);
+    Node* prev = nullptr;
+    for (Node* current = head_; current; current = current->next) {
+        current->prev = prev;
+        prev = current;
+    }
+    tail_ = prev;
+    reset_cursor();
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::sort() {
+    merge_sort(std::less<T>());
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::sort(const std::function<bool(const T&, const T&)>& less) {
+    merge_sort(less);
+}
+
+template <typename T, typename Allocator>
+std::vector<T> DoublyLinkedList<T, Allocator>::to_vector() const {
     std::vector<T> result;
     result.reserve(size_);
 
-    DListNode<T>* current = head_;
+    Node* current = head_;
     while (current) {
         result.push_back(current->data);
         current = current->next;
@@ -663,12 +1181,12 @@ std::vector<T> DoublyLinkedList<T>::to_vector() const {
     return result;
 }
 
-template <typename T>
-std::vector<T> DoublyLinkedList<T>::to_vector_reverse() const {
+template <typename T, typename Allocator>
+std::vector<T> DoublyLinkedList<T, Allocator>::to_vector_reverse() const {
     std::vector<T> result;
     result.reserve(size_);
 
-    DListNode<T>* current = tail_;
+    Node* current = tail_;
     while (current) {
         result.push_back(current->data);
         current = current->prev;
@@ -677,24 +1195,561 @@ std::vector<T> DoublyLinkedList<T>::to_vector_reverse() const {
     return result;
 }
 
-template <typename T>
-void DoublyLinkedList<T>::for_each_forward(const std::function<void(T&)>& fn) {
-    DListNode<T>* current = head_;
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::for_each_forward(const std::function<void(T&)>& fn) {
+    Node* current = head_;
     while (current) {
         fn(current->data);
         current = current->next;
     }
 }
 
-template <typename T>
-void DoublyLinkedList<T>::for_each_backward(const std::function<void(T&)>& fn) {
-    DListNode<T>* current = tail_;
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::for_each_backward(const std::function<void(T&)>& fn) {
+    Node* current = tail_;
     while (current) {
         fn(current->data);
         current = current->prev;
     }
 }
 
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::iterator DoublyLinkedList<T, Allocator>::begin() {
+    return iterator(head_, this);
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::iterator DoublyLinkedList<T, Allocator>::end() {
+    return iterator(nullptr, this);
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::const_iterator DoublyLinkedList<T, Allocator>::begin() const {
+    return const_iterator(head_, this);
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::const_iterator DoublyLinkedList<T, Allocator>::end() const {
+    return const_iterator(nullptr, this);
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::const_iterator DoublyLinkedList<T, Allocator>::cbegin() const {
+    return begin();
+}
+
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::const_iterator DoublyLinkedList<T, Allocator>::cend() const {
+    return end();
+}
+
+// =============================================================================
+// UnrolledLinkedList
+// =============================================================================
+
+template <typename T, typename Allocator>
+UnrolledLinkedList<T, Allocator>::UnrolledLinkedList() : head_(nullptr), tail_(nullptr), size_(0) {}
+
+template <typename T, typename Allocator>
+UnrolledLinkedList<T, Allocator>::~UnrolledLinkedList() {
+    clear();
+}
+
+template <typename T, typename Allocator>
+UnrolledLinkedList<T, Allocator>::UnrolledLinkedList(const UnrolledLinkedList& other)
+    : head_(nullptr), tail_(nullptr), size_(0),
+      alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+    copy_from(other);
+}
+
+template <typename T, typename Allocator>
+UnrolledLinkedList<T, Allocator>::UnrolledLinkedList(UnrolledLinkedList&& other) noexcept
+    : head_(other.head_), tail_(other.tail_), size_(other.size_), alloc_(std::move(other.alloc_)) {
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.size_ = 0;
+}
+
+template <typename T, typename Allocator>
+UnrolledLinkedList<T, Allocator>& UnrolledLinkedList<T, Allocator>::operator=(const UnrolledLinkedList& other) {
+    if (this != &other) {
+        clear();
+        copy_from(other);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+UnrolledLinkedList<T, Allocator>& UnrolledLinkedList<T, Allocator>::operator=(UnrolledLinkedList&& other) noexcept {
+    if (this != &other) {
+        clear();
+        static_assert(NodeTraits::propagate_on_container_move_assignment::value,
+                      "Node allocator must propagate on move assignment");
+        alloc_ = std::move(other.alloc_);
+        head_ = other.head_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::copy_from(const UnrolledLinkedList& other) {
+    for (const Node* node = other.head_; node; node = node->next) {
+        const T* items = node->items();
+        for (size_t i = 0; i < node->count; ++i) {
+            push_back(items[i]);
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+typename UnrolledLinkedList<T, Allocator>::Node* UnrolledLinkedList<T, Allocator>::create_node() {
+    Node* node = NodeTraits::allocate(alloc_, 1);
+    NodeTraits::construct(alloc_, node);
+    return node;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::destroy_node(Node* node) {
+    NodeTraits::destroy(alloc_, node);
+    NodeTraits::deallocate(alloc_, node, 1);
+}
+
+template <typename T, typename Allocator>
+typename UnrolledLinkedList<T, Allocator>::Node* UnrolledLinkedList<T, Allocator>::locate(size_t& index) const {
+    // Appends and back() land in the tail, so check it before walking
+    size_t tail_start = size_ - tail_->count;
+    if (index >= tail_start) {
+        index -= tail_start;
+        return tail_;
+    }
+
+    Node* node = head_;
+    while (index >= node->count) {
+        index -= node->count;
+        node = node->next;
+    }
+    return node;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::insert_into(Node* node, size_t offset, T&& value) {
+    T* items = node->items();
+    size_t count = node->count;
+
+    if (offset == count) {
+        std::construct_at(items + count, std::move(value));
+        ++node->count;
+    } else {
+        std::construct_at(items + count, std::move(items[count - 1]));
+        ++node->count;
+        std::move_backward(items + offset, items + count - 1, items + count);
+        items[offset] = std::move(value);
+    }
+    ++size_;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::erase_from(Node* prev, Node* node, size_t offset) {
+    T* items = node->items();
+    std::move(items + offset + 1, items + node->count, items + offset);
+    std::destroy_at(items + node->count - 1);
+    --node->count;
+    --size_;
+
+    if (node->count == 0) {
+        unlink(prev, node);
+        return;
+    }
+
+    // Merge an underfull node with its successor to keep nodes dense
+    Node* next = node->next;
+    if (next && node->count < NODE_CAPACITY / 2 && node->count + next->count <= NODE_CAPACITY) {
+        T* next_items = next->items();
+        std::uninitialized_move(next_items, next_items + next->count, items + node->count);
+        std::destroy(next_items, next_items + next->count);
+        node->count += next->count;
+        next->count = 0;
+        unlink(node, next);
+    }
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::unlink(Node* prev, Node* node) {
+    if (prev) {
+        prev->next = node->next;
+    } else {
+        head_ = node->next;
+    }
+    if (node == tail_) {
+        tail_ = prev;
+    }
+    destroy_node(node);
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::push_front(const T& value) {
+    T item(value);  // value may live in the node that is about to shift
+
+    if (head_ && head_->count < NODE_CAPACITY) {
+        insert_into(head_, 0, std::move(item));
+        return;
+    }
+
+    Node* node = create_node();
+    try {
+        std::construct_at(node->items(), std::move(item));
+    } catch (...) {
+        destroy_node(node);
+        throw;
+    }
+    node->count = 1;
+    node->next = head_;
+    head_ = node;
+    if (!tail_) {
+        tail_ = node;
+    }
+    ++size_;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::push_back(const T& value) {
+    Node* node = tail_;
+    if (!node || node->count == NODE_CAPACITY) {
+        node = create_node();
+    }
+
+    try {
+        std::construct_at(node->items() + node->count, value);
+    } catch (...) {
+        if (node != tail_) {
+            destroy_node(node);
+        }
+        throw;
+    }
+    ++node->count;
+    ++size_;
+
+    if (node != tail_) {
+        if (tail_) {
+            tail_->next = node;
+        } else {
+            head_ = node;
+        }
+        tail_ = node;
+    }
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::insert_at(size_t index, const T& value) {
+    if (index > size_) {
+        throw std::out_of_range("Index out of range");
+    }
+
+    if (index == size_) {
+        push_back(value);
+        return;
+    }
+
+    T item(value);
+    Node* node = locate(index);
+
+    if (node->count == NODE_CAPACITY) {
+        // Split the full node, moving its upper half into a new successor
+        Node* sibling = create_node();
+        size_t keep = NODE_CAPACITY / 2;
+        T* items = node->items();
+        try {
+            std::uninitialized_move(items + keep, items + NODE_CAPACITY, sibling->items());
+        } catch (...) {
+            destroy_node(sibling);
+            throw;
+        }
+        std::destroy(items + keep, items + NODE_CAPACITY);
+        sibling->count = NODE_CAPACITY - keep;
+        node->count = keep;
+
+        sibling->next = node->next;
+        node->next = sibling;
+        if (node == tail_) {
+            tail_ = sibling;
+        }
+
+        if (index > keep) {
+            node = sibling;
+            index -= keep;
+        }
+    }
+
+    insert_into(node, index, std::move(item));
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::pop_front() {
+    if (empty()) {
+        throw std::runtime_error("Pop from empty list");
+    }
+    erase_from(nullptr, head_, 0);
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::pop_back() {
+    if (empty()) {
+        throw std::runtime_error("Pop from empty list");
+    }
+
+    // The predecessor is only needed when the tail node empties
+    Node* prev = nullptr;
+    if (tail_->count == 1) {
+        for (Node* node = head_; node != tail_; node = node->next) {
+            prev = node;
+        }
+    }
+    erase_from(prev, tail_, tail_->count - 1);
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::remove_at(size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of range");
+    }
+
+    Node* prev = nullptr;
+    Node* node = head_;
+    while (index >= node->count) {
+        index -= node->count;
+        prev = node;
+        node = node->next;
+    }
+    erase_from(prev, node, index);
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::remove_value(const T& value) {
+    Node* prev = nullptr;
+    for (Node* node = head_; node; prev = node, node = node->next) {
+        T* items = node->items();
+        for (size_t i = 0; i < node->count; ++i) {
+            if (items[i] == value) {
+                erase_from(prev, node, i);
+                return;
+            }
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::clear() {
+    while (head_) {
+        Node* node = head_;
+        head_ = head_->next;
+        std::destroy(node->items(), node->items() + node->count);
+        destroy_node(node);
+    }
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::reserve(size_t count) {
+    if (count <= size_) return;
+    if constexpr (requires(NodeAllocator& alloc) { alloc.reserve(count); }) {
+        alloc_.reserve((count - size_ + NODE_CAPACITY - 1) / NODE_CAPACITY);
+    }
+}
+
+template <typename T, typename Allocator>
+T& UnrolledLinkedList<T, Allocator>::front() {
+    if (empty()) throw std::runtime_error("Empty list");
+    return head_->items()[0];
+}
+
+template <typename T, typename Allocator>
+const T& UnrolledLinkedList<T, Allocator>::front() const {
+    if (empty()) throw std::runtime_error("Empty list");
+    return head_->items()[0];
+}
+
+template <typename T, typename Allocator>
+T& UnrolledLinkedList<T, Allocator>::back() {
+    if (empty()) throw std::runtime_error("Empty list");
+    return tail_->items()[tail_->count - 1];
+}
+
+template <typename T, typename Allocator>
+const T& UnrolledLinkedList<T, Allocator>::back() const {
+    if (empty()) throw std::runtime_error("Empty list");
+    return tail_->items()[tail_->count - 1];
+}
+
+template <typename T, typename Allocator>
+T& UnrolledLinkedList<T, Allocator>::at(size_t index) {
+    if (index >= size_) throw std::out_of_range("Index out of range");
+    Node* node = locate(index);
+    return node->items()[index];
+}
+
+template <typename T, typename Allocator>
+const T& UnrolledLinkedList<T, Allocator>::at(size_t index) const {
+    if (index >= size_) throw std::out_of_range("Index out of range");
+    const Node* node = locate(index);
+    return node->items()[index];
+}
+
+template <typename T, typename Allocator>
+std::optional<T> UnrolledLinkedList<T, Allocator>::find(const T& value) const {
+    for (const Node* node = head_; node; node = node->next) {
+        const T* items = node->items();
+        const T* match = std::find(items, items + node->count, value);
+        if (match != items + node->count) {
+            return *match;
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename T, typename Allocator>
+size_t UnrolledLinkedList<T, Allocator>::size() const {
+    return size_;
+}
+
+template <typename T, typename Allocator>
+bool UnrolledLinkedList<T, Allocator>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T, typename Allocator>
+bool UnrolledLinkedList<T, Allocator>::contains(const T& value) const {
+    return find(value).has_value();
+}
+
+template <typename T, typename Allocator>
+size_t UnrolledLinkedList<T, Allocator>::count(const T& value) const {
+    size_t cnt = 0;
+    for (const Node* node = head_; node; node = node->next) {
+        const T* items = node->items();
+        cnt += static_cast<size_t>(std::count(items, items + node->count, value));
+    }
+    return cnt;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::reverse() {
+    Node* prev = nullptr;
+    Node* current = head_;
+    tail_ = head_;
+
+    while (current) {
+        std::reverse(current->items(), current->items() + current->count);
+        Node* next = current->next;
+        current->next = prev;
+        prev = current;
+        current = next;
+    }
+
+    head_ = prev;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::sort() {
+    sort_values(std::less<T>());
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::sort(const std::function<bool(const T&, const T&)>& less) {
+    sort_values(less);
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::pack() {
+    // Every slot from the write position up to the read position is either
+    // past its node's original count or already moved out and destroyed
+    Node* dest = head_;
+    size_t filled = 0;
+    for (Node* node = head_; node; node = node->next) {
+        T* items = node->items();
+        for (size_t i = 0; i < node->count; ++i) {
+            if (filled == NODE_CAPACITY) {
+                dest = dest->next;
+                filled = 0;
+            }
+            if (dest != node || filled != i) {
+                std::construct_at(dest->items() + filled, std::move(items[i]));
+                std::destroy_at(items + i);
+            }
+            ++filled;
+        }
+    }
+
+    for (Node* node = head_; node != dest; node = node->next) {
+        node->count = NODE_CAPACITY;
+    }
+    dest->count = filled;
+    for (Node* node = dest->next; node;) {
+        Node* next = node->next;
+        destroy_node(node);
+        node = next;
+    }
+    dest->next = nullptr;
+    tail_ = dest;
+}
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void UnrolledLinkedList<T, Allocator>::sort_values(const Compare& less) {
+    if (size_ <= 1) return;
+
+    // With full nodes an element's position follows from its index, so the
+    // elements can be sorted where they are through a table of the nodes.
+    // std::stable_sort still takes a temporary buffer of up to half the
+    // elements when it can get one, and merges by rotation otherwise
+    pack();
+    std::vector<Node*> table;
+    table.reserve((size_ + NODE_CAPACITY - 1) / NODE_CAPACITY);
+    for (Node* node = head_; node; node = node->next) {
+        table.push_back(node);
+    }
+
+    using Iterator = PackedNodeIterator<Node, T>;
+    std::stable_sort(Iterator(table.data(), 0), Iterator(table.data(), size_), less);
+}
+
+template <typename T, typename Allocator>
+std::vector<T> UnrolledLinkedList<T, Allocator>::to_vector() const {
+    std::vector<T> result;
+    result.reserve(size_);
+
+    for (const Node* node = head_; node; node = node->next) {
+        result.insert(result.end(), node->items(), node->items() + node->count);
+    }
+
+    return result;
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::for_each(const std::function<void(T&)>& fn) {
+    for (Node* node = head_; node; node = node->next) {
+        T* items = node->items();
+        for (size_t i = 0; i < node->count; ++i) {
+            fn(items[i]);
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+void UnrolledLinkedList<T, Allocator>::for_each(const std::function<void(const T&)>& fn) const {
+    for (const Node* node = head_; node; node = node->next) {
+        const T* items = node->items();
+        for (size_t i = 0; i < node->count; ++i) {
+            fn(items[i]);
+        }
+    }
+}
+
 // Explicit template instantiations for common types
 template class SinglyLinkedList<int>;
 template class SinglyLinkedList<double>;
@@ -702,5 +1757,17 @@ template class SinglyLinkedList<std::string>;
 template class DoublyLinkedList<int>;
 template class DoublyLinkedList<double>;
 template class DoublyLinkedList<std::string>;
+template class UnrolledLinkedList<int>;
+template class UnrolledLinkedList<double>;
+template class UnrolledLinkedList<std::string>;
+template class SinglyLinkedList<int, std::allocator<int>>;
+template class SinglyLinkedList<double, std::allocator<double>>;
+template class SinglyLinkedList<std::string, std::allocator<std::string>>;
+template class DoublyLinkedList<int, std::allocator<int>>;
+template class DoublyLinkedList<double, std::allocator<double>>;
+template class DoublyLinkedList<std::string, std::allocator<std::string>>;
+template class UnrolledLinkedList<int, std::allocator<int>>;
+template class UnrolledLinkedList<double, std::allocator<double>>;
+template class UnrolledLinkedList<std::string, std::allocator<std::string>>;
 
 }  // namespace temp2::containers
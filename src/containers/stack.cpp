@@ -1,4 +1,7 @@
 #include "containers/stack.hpp"
+#include <bit>
+#include <memory>
+#include <utility>
 
 namespace temp2::containers {
 
@@ -226,6 +229,274 @@ void LinkedStack<T>::clear() {
     size_ = 0;
 }
 
+// =============================================================================
+// ConcurrentStack
+// =============================================================================
+
+namespace {
+
+// Head words pack a node index (0 = empty) with an ABA tag
+constexpr uint64_t pack_head(uint32_t index, uint32_t tag) {
+    return (static_cast<uint64_t>(tag) << 32) | index;
+}
+
+constexpr uint32_t head_index(uint64_t head) {
+    return static_cast<uint32_t>(head);
+}
+
+constexpr uint32_t head_tag(uint64_t head) {
+    return static_cast<uint32_t>(head >> 32);
+}
+
+// Chunk k holds first << k nodes and starts at slot first * (2^k - 1)
+size_t chunk_of(size_t slot, size_t first) {
+    return static_cast<size_t>(std::bit_width(slot / first + 1)) - 1;
+}
+
+size_t chunk_start(size_t chunk, size_t first) {
+    return first * ((size_t{1} << chunk) - 1);
+}
+
+}  // namespace
+
+template <typename T>
+ConcurrentStack<T>::ConcurrentStack() : head_(0), free_(0), size_(0), next_slot_(0) {
+    for (auto& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+ConcurrentStack<T>::~ConcurrentStack() {
+    for (uint32_t index = head_index(head_.load(std::memory_order_acquire)); index;) {
+        Node& n = node(index);
+        std::destroy_at(n.value());
+        index = n.next.load(std::memory_order_relaxed);
+    }
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+typename ConcurrentStack<T>::Node& ConcurrentStack<T>::node(uint32_t index) const {
+    size_t slot = index - 1;
+    size_t chunk = chunk_of(slot, FIRST_CHUNK_NODES);
+    return chunks_[chunk].load(std::memory_order_acquire)[slot - chunk_start(chunk, FIRST_CHUNK_NODES)];
+}
+
+template <typename T>
+typename ConcurrentStack<T>::Node* ConcurrentStack<T>::chunk(size_t index) {
+    Node* existing = chunks_[index].load(std::memory_order_acquire);
+    if (existing) return existing;
+
+    // Several threads may race to allocate the same chunk; one wins
+    Node* fresh = new Node[FIRST_CHUNK_NODES << index];
+    if (chunks_[index].compare_exchange_strong(existing, fresh, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+        return fresh;
+    }
+    delete[] fresh;
+    return existing;
+}
+
+template <typename T>
+uint32_t ConcurrentStack<T>::acquire_node() {
+    if (uint32_t index = pop_index(free_)) {
+        return index;
+    }
+
+    size_t slot = next_slot_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= chunk_start(MAX_CHUNKS, FIRST_CHUNK_NODES)) {
+        throw std::length_error("ConcurrentStack node capacity exceeded");
+    }
+    chunk(chunk_of(slot, FIRST_CHUNK_NODES));
+    return static_cast<uint32_t>(slot + 1);
+}
+
+template <typename T>
+uint32_t ConcurrentStack<T>::pop_index(std::atomic<uint64_t>& head) {
+    uint64_t old = head.load(std::memory_order_acquire);
+    while (head_index(old) != 0) {
+        // The node may be recycled under us; its memory stays valid and the tag makes the CAS fail
+        uint32_t next = node(head_index(old)).next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(old, pack_head(next, head_tag(old) + 1), std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+            return head_index(old);
+        }
+    }
+    return 0;
+}
+
+template <typename T>
+void ConcurrentStack<T>::push_chain(std::atomic<uint64_t>& head, uint32_t first, uint32_t last) {
+    Node& tail = node(last);
+    uint64_t old = head.load(std::memory_order_relaxed);
+    do {
+        tail.next.store(head_index(old), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old, pack_head(first, head_tag(old) + 1), std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+template <typename T>
+template <typename U>
+void ConcurrentStack<T>::push_value(U&& value) {
+    uint32_t index = acquire_node();
+    try {
+        std::construct_at(reinterpret_cast<T*>(node(index).storage), std::forward<U>(value));
+    } catch (...) {
+        push_chain(free_, index, index);
+        throw;
+    }
+    // Count before publishing so a racing pop never takes size below zero
+    size_.fetch_add(1, std::memory_order_relaxed);
+    push_chain(head_, index, index);
+}
+
+template <typename T>
+void ConcurrentStack<T>::push(const T& value) {
+    push_value(value);
+}
+
+template <typename T>
+void ConcurrentStack<T>::push(T&& value) {
+    push_value(std::move(value));
+}
+
+template <typename T>
+void ConcurrentStack<T>::push_range(std::span<const T> values) {
+    if (values.empty()) return;
+
+    // Link the nodes privately, last value on top, then publish with one CAS
+    uint32_t first = 0;
+    uint32_t last = 0;
+    try {
+        for (const T& value : values) {
+            uint32_t index = acquire_node();
+            Node& n = node(index);
+            try {
+                std::construct_at(reinterpret_cast<T*>(n.storage), value);
+            } catch (...) {
+                push_chain(free_, index, index);
+                throw;
+            }
+            n.next.store(first, std::memory_order_relaxed);
+            if (!last) {
+                last = index;
+            }
+            first = index;
+        }
+    } catch (...) {
+        for (uint32_t index = first; index; index = node(index).next.load(std::memory_order_relaxed)) {
+            std::destroy_at(node(index).value());
+        }
+        if (first) {
+            push_chain(free_, first, last);
+        }
+        throw;
+    }
+
+    size_.fetch_add(values.size(), std::memory_order_relaxed);
+    push_chain(head_, first, last);
+}
+
+template <typename T>
+T ConcurrentStack<T>::pop() {
+    std::optional<T> value = try_pop();
+    if (!value) {
+        throw std::runtime_error("Pop from empty stack");
+    }
+    return std::move(*value);
+}
+
+template <typename T>
+std::optional<T> ConcurrentStack<T>::try_pop() {
+    uint32_t index = pop_index(head_);
+    if (!index) {
+        return std::nullopt;
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+
+    Node& n = node(index);
+    std::optional<T> value(std::move(*n.value()));
+    std::destroy_at(n.value());
+    push_chain(free_, index, index);
+    return value;
+}
+
+template <typename T>
+std::vector<T> ConcurrentStack<T>::pop_all() {
+    std::vector<T> values;
+    values.reserve(size_.load(std::memory_order_relaxed));
+
+    uint64_t old = head_.load(std::memory_order_relaxed);
+    while (head_index(old) != 0 && !head_.compare_exchange_weak(old, pack_head(0, head_tag(old) + 1),
+                                                                 std::memory_order_acquire,
+                                                                 std::memory_order_relaxed)) {
+    }
+    uint32_t first = head_index(old);
+    if (!first) {
+        return values;
+    }
+
+    // The detached chain is private now; stale poppers only read it
+    uint32_t index = first;
+    uint32_t consumed = 0;
+    size_t count = 0;
+    try {
+        while (index) {
+            Node& n = node(index);
+            values.push_back(std::move(*n.value()));
+            std::destroy_at(n.value());
+            consumed = index;
+            index = n.next.load(std::memory_order_relaxed);
+            ++count;
+        }
+    } catch (...) {
+        // Hand the unconsumed rest back to the stack
+        uint32_t tail = index;
+        while (uint32_t next = node(tail).next.load(std::memory_order_relaxed)) {
+            tail = next;
+        }
+        push_chain(head_, index, tail);
+        if (consumed) {
+            size_.fetch_sub(count, std::memory_order_relaxed);
+            push_chain(free_, first, consumed);
+        }
+        throw;
+    }
+
+    size_.fetch_sub(count, std::memory_order_relaxed);
+    push_chain(free_, first, consumed);
+    return values;
+}
+
+template <typename T>
+size_t ConcurrentStack<T>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+bool ConcurrentStack<T>::empty() const {
+    return head_index(head_.load(std::memory_order_acquire)) == 0;
+}
+
+template <typename T>
+void ConcurrentStack<T>::clear() {
+    while (try_pop()) {
+    }
+}
+
+template <typename T>
+void ConcurrentStack<T>::reserve(size_t count) {
+    if (count > chunk_start(MAX_CHUNKS, FIRST_CHUNK_NODES)) {
+        throw std::length_error("ConcurrentStack node capacity exceeded");
+    }
+    for (size_t index = 0; index < MAX_CHUNKS && chunk_start(index, FIRST_CHUNK_NODES) < count; ++index) {
+        chunk(index);
+    }
+}
+
 // =============================================================================
 // MinStack
 // =============================================================================
@@ -373,6 +644,9 @@ template class ArrayStack<std::string>;
 template class LinkedStack<int>;
 template class LinkedStack<double>;
 template class LinkedStack<std::string>;
+template class ConcurrentStack<int>;
+template class ConcurrentStack<double>;
+template class ConcurrentStack<std::string>;
 template class MinStack<int>;
 template class MinStack<double>;
 template class MaxStack<int>;
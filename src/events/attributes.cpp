@@ -0,0 +1,118 @@
+#include "events/attributes.hpp"
+#include <typeinfo>
+
+namespace temp2::events {
+
+NameRegistry& attribute_key_registry() {
+    static NameRegistry registry;
+    return registry;
+}
+
+// =============================================================================
+// AttributeValue
+// =============================================================================
+
+AttributeValue AttributeValue::from_any(const std::any& value) {
+    AttributeValue result;
+    if (!value.has_value()) {
+        return result;
+    }
+
+    const std::type_info& type = value.type();
+    if (type == typeid(bool)) {
+        result.storage_ = std::any_cast<bool>(value);
+    } else if (type == typeid(int)) {
+        result.storage_ = std::any_cast<int>(value);
+    } else if (type == typeid(int64_t)) {
+        result.storage_ = std::any_cast<int64_t>(value);
+    } else if (type == typeid(double)) {
+        result.storage_ = std::any_cast<double>(value);
+    } else if (type == typeid(std::string)) {
+        result.storage_ = std::any_cast<const std::string&>(value);
+    } else {
+        result.storage_ = value;
+    }
+    return result;
+}
+
+std::any AttributeValue::to_any() const {
+    return std::visit([](const auto& value) -> std::any {
+        using U = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<U, std::monostate>) {
+            return {};
+        } else if constexpr (std::is_same_v<U, std::any>) {
+            return value;
+        } else {
+            return std::any(value);
+        }
+    }, storage_);
+}
+
+bool AttributeValue::empty() const {
+    return std::holds_alternative<std::monostate>(storage_);
+}
+
+const AttributeValue::Storage& AttributeValue::storage() const {
+    return storage_;
+}
+
+// =============================================================================
+// AttributeStore
+// =============================================================================
+
+AttributeStore::AttributeStore() : inline_size_(0) {}
+
+void AttributeStore::set(AttributeKey key, AttributeValue value) {
+    if (AttributeValue* existing = find_mutable(key)) {
+        *existing = std::move(value);
+        return;
+    }
+
+    if (inline_size_ < INLINE_CAPACITY) {
+        inline_[inline_size_].key = key;
+        inline_[inline_size_].value = std::move(value);
+        ++inline_size_;
+    } else {
+        overflow_.push_back(Entry{key, std::move(value)});
+    }
+}
+
+AttributeValue* AttributeStore::find_mutable(AttributeKey key) {
+    for (size_t i = 0; i < inline_size_; ++i) {
+        if (inline_[i].key == key) {
+            return &inline_[i].value;
+        }
+    }
+    for (auto& entry : overflow_) {
+        if (entry.key == key) {
+            return &entry.value;
+        }
+    }
+    return nullptr;
+}
+
+const AttributeValue* AttributeStore::find(AttributeKey key) const {
+    return const_cast<AttributeStore*>(this)->find_mutable(key);
+}
+
+bool AttributeStore::contains(AttributeKey key) const {
+    return find(key) != nullptr;
+}
+
+size_t AttributeStore::size() const {
+    return inline_size_ + overflow_.size();
+}
+
+bool AttributeStore::empty() const {
+    return size() == 0;
+}
+
+void AttributeStore::clear() {
+    for (size_t i = 0; i < inline_size_; ++i) {
+        inline_[i].value = AttributeValue();
+    }
+    inline_size_ = 0;
+    overflow_.clear();
+}
+
+}  // namespace temp2::events
@@ -0,0 +1,32 @@
+#include "events/awaitable.hpp"
+#include "events/dispatcher.hpp"
+#include <stdexcept>
+
+namespace temp2::events {
+
+// =============================================================================
+// EventWaiter
+// =============================================================================
+
+EventWaiter::EventWaiter(EventDispatcher& dispatcher, EventTypeId type_id, MatchFunc matches)
+    : dispatcher_(&dispatcher)
+    , type_id_(type_id)
+    , matches_(matches)
+    , event_(nullptr)
+    , state_(State::Idle) {}
+
+EventWaiter::~EventWaiter() {
+    if (dispatcher_ && (state_ == State::Waiting || state_ == State::Firing)) {
+        dispatcher_->remove_waiter(*this);
+    }
+}
+
+void EventWaiter::suspend(std::coroutine_handle<> handle) {
+    if (!dispatcher_) {
+        throw std::logic_error("Awaiting an event of a destroyed dispatcher");
+    }
+    handle_ = handle;
+    dispatcher_->add_waiter(*this);
+}
+
+}  // namespace temp2::events
@@ -1,107 +1,1378 @@
 #include "events/dispatcher.hpp"
 #include <algorithm>
+#include <iterator>
+#include <stdexcept>
 
 namespace temp2::events {
 
+namespace {
+
+void link_waiter(WaiterLink& list, WaiterLink& link) {
+    link.prev = list.prev;
+    link.next = &list;
+    list.prev->next = &link;
+    list.prev = &link;
+}
+
+void unlink_waiter(WaiterLink& link) {
+    link.prev->next = link.next;
+    link.next->prev = link.prev;
+    link.prev = &link;
+    link.next = &link;
+}
+
+const NameRegistry::Entry& coalesced_type() {
+    static const NameRegistry::Entry type = event_type_registry().intern_entry("dispatcher.coalesced");
+    return type;
+}
+
+}  // namespace
+
+/**
+ * @brief Pending result of one coalescing key
+ *
+ * Guarded by coalesce_mutex_, except that the placeholder's destructor may
+ * close it at any time (a DropOldest eviction, say); a closed slot no longer
+ * takes events.
+ */
+struct EventDispatcher::CoalesceSlot {
+    std::pair<EventTypeId, uint64_t> key;
+    std::unique_ptr<Event> pending;
+    std::atomic<bool> closed{false};
+};
+
+/**
+ * @brief Placeholder queued in a lane in place of a coalesced event
+ *
+ * Holds the lane position and capacity of the key's first event while later
+ * ones are folded into its slot; dispatch_events swaps in the result.
+ */
+class EventDispatcher::CoalescedEvent : public Event {
+public:
+    explicit CoalescedEvent(std::shared_ptr<CoalesceSlot> slot)
+        : Event(coalesced_type()), slot_(std::move(slot)) {}
+
+    ~CoalescedEvent() override { slot_->closed.store(true, std::memory_order_relaxed); }
+
+    const std::shared_ptr<CoalesceSlot>& slot() const { return slot_; }
+
+private:
+    std::shared_ptr<CoalesceSlot> slot_;
+};
+
 // =============================================================================
 // EventDispatcher
 // =============================================================================
 
-EventDispatcher::EventDispatcher() : next_id_(1) {}
+EventDispatcher::EventDispatcher() : EventDispatcher(QueueConfig()) {}
+
+EventDispatcher::EventDispatcher(const QueueConfig& config)
+    : resolved_types_(SIZE_MAX)
+    , live_handles_(0)
+    , tombstones_(0)
+    , retired_dropped_(0)
+    , lane_routing_(false)
+    , batch_dispatch_(false)
+    , coalescing_enabled_(false)
+    , coalesced_(0)
+    , observing_(false)
+    , waiting_(0)
+    , timer_count_(0)
+    , metrics_(nullptr)
+    , next_id_(1) {
+    for (auto& queue : queues_) {
+        queue = std::make_unique<EventQueue>(config);
+    }
+    set_lane_weights(4, 2, 1);
+}
 
 EventDispatcher::~EventDispatcher() {
+    stop_workers(false);
+    stop_fan_out();
     clear();
+
+    // Observers still added must not remove themselves from a dead dispatcher.
+    // Iterate a copy in case a callback removes its observer anyway
+    std::vector<ObserverEntry> observers = observers_.writer_view().observers;
+    for (const ObserverEntry& entry : observers) {
+        if (entry.on_destroyed) {
+            entry.on_destroyed();
+        }
+    }
+
+    // Flows still waiting are never resumed; their waiters must not call back
+    std::lock_guard<std::mutex> lock(waiters_mutex_);
+    for (WaiterLink& list : waiter_lists_) {
+        while (list.next != &list) {
+            auto& waiter = static_cast<EventWaiter&>(*list.next);
+            unlink_waiter(*list.next);
+            waiter.dispatcher_ = nullptr;
+            waiter.state_ = EventWaiter::State::Idle;
+        }
+    }
 }
 
+namespace {
+
+static_assert(sizeof(HandlerId) >= sizeof(uint64_t), "HandlerId packs a generation and a slot index");
+
+// "net.*" and "*" subscribe to a namespace; the stored prefix is "net." or ""
+bool is_pattern(const std::string& event_type) {
+    if (event_type.find('*') == std::string::npos) return false;
+    if (event_type == "*") return true;
+    if (event_type.size() > 2 && event_type.compare(event_type.size() - 2, 2, ".*") == 0 &&
+        event_type.find('*') == event_type.size() - 1) {
+        return true;
+    }
+    throw std::invalid_argument("Unsupported event type pattern: " + event_type);
+}
+
+std::string pattern_prefix(const std::string& pattern) {
+    return pattern.substr(0, pattern.size() - 1);
+}
+
+bool matches_prefix(const std::string& type, const std::string& prefix) {
+    return type.size() > prefix.size() && type.compare(0, prefix.size(), prefix) == 0;
+}
+
+}  // namespace
+
 HandlerId EventDispatcher::subscribe(const std::string& event_type, EventHandler handler, int priority) {
-    HandlerId id = next_id_++;
+    auto subscription = std::make_shared<Subscription>();
+    subscription->handler = std::move(handler);
+    if (is_pattern(event_type)) {
+        return add_wildcard(pattern_prefix(event_type), std::move(subscription), priority);
+    }
+    return add_entry(event_type_registry().intern(event_type), std::move(subscription), priority);
+}
+
+HandlerId EventDispatcher::subscribe(EventTypeId type_id, EventHandler handler, int priority) {
+    auto subscription = std::make_shared<Subscription>();
+    subscription->handler = std::move(handler);
+    return add_entry(type_id, std::move(subscription), priority);
+}
+
+HandlerId EventDispatcher::subscribe_batch(const std::string& event_type, BatchEventHandler handler,
+                                           int priority) {
+    auto subscription = std::make_shared<Subscription>();
+    subscription->batch_handler = std::move(handler);
+    if (is_pattern(event_type)) {
+        return add_wildcard(pattern_prefix(event_type), std::move(subscription), priority);
+    }
+    return add_entry(event_type_registry().intern(event_type), std::move(subscription), priority);
+}
+
+HandlerId EventDispatcher::subscribe_batch(EventTypeId type_id, BatchEventHandler handler, int priority) {
+    auto subscription = std::make_shared<Subscription>();
+    subscription->batch_handler = std::move(handler);
+    return add_entry(type_id, std::move(subscription), priority);
+}
+
+HandlerId EventDispatcher::subscribe_parallel(const std::string& event_type, EventHandler handler,
+                                              int priority) {
+    auto subscription = std::make_shared<Subscription>();
+    subscription->handler = std::move(handler);
+    subscription->parallel_safe = true;
+    if (is_pattern(event_type)) {
+        return add_wildcard(pattern_prefix(event_type), std::move(subscription), priority);
+    }
+    return add_entry(event_type_registry().intern(event_type), std::move(subscription), priority);
+}
+
+HandlerId EventDispatcher::subscribe_parallel(EventTypeId type_id, EventHandler handler, int priority) {
+    auto subscription = std::make_shared<Subscription>();
+    subscription->handler = std::move(handler);
+    subscription->parallel_safe = true;
+    return add_entry(type_id, std::move(subscription), priority);
+}
 
-    HandlerEntry entry{id, std::move(handler), priority};
-    auto& handler_list = handlers_[event_type];
+HandlerId EventDispatcher::add_entry(EventTypeId type_id, std::shared_ptr<Subscription> subscription,
+                                     int priority) {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    HandlerId id = allocate_handle(type_id, false, std::string(), subscription);
+    HandlerEntry entry{id, std::move(subscription), priority, next_id_++, false};
+
+    auto table = copy_table();
+    auto handler_list = std::make_shared<HandlerList>();
+    if (type_id < table->lists.size() && table->lists[type_id]) {
+        *handler_list = *table->lists[type_id];
+    }
 
     // Insert sorted by priority (higher priority first)
-    auto it = std::lower_bound(handler_list.begin(), handler_list.end(), entry,
+    auto it = std::lower_bound(handler_list->begin(), handler_list->end(), entry,
         [](const HandlerEntry& a, const HandlerEntry& b) {
             return a.priority > b.priority;
         });
-    handler_list.insert(it, std::move(entry));
+    handler_list->insert(it, std::move(entry));
 
+    if (type_id >= table->lists.size()) {
+        table->lists.resize(static_cast<size_t>(type_id) + 1);
+    }
+    table->lists[type_id] = std::move(handler_list);
+    commit_table(std::move(table));
     return id;
 }
 
-void EventDispatcher::unsubscribe(HandlerId id) {
-    for (auto& [type, handler_list] : handlers_) {
-        auto it = std::remove_if(handler_list.begin(), handler_list.end(),
-            [id](const HandlerEntry& entry) { return entry.id == id; });
-        handler_list.erase(it, handler_list.end());
+HandlerId EventDispatcher::add_wildcard(std::string prefix, std::shared_ptr<Subscription> subscription,
+                                        int priority) {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    HandlerId id = allocate_handle(0, true, prefix, subscription);
+    HandlerEntry entry{id, std::move(subscription), priority, next_id_++, true};
+
+    auto table = copy_table();
+    table->wildcards.push_back(WildcardEntry{prefix, std::move(entry)});
+    rebuild_matching(*table, prefix);
+    commit_table(std::move(table));
+    return id;
+}
+
+std::unique_ptr<EventDispatcher::HandlerTable> EventDispatcher::copy_table() {
+    auto table = std::make_unique<HandlerTable>(handlers_.writer_view());
+
+    // Resolve wildcards for every type interned since the last version
+    const size_t type_count = event_type_registry().size();
+    if (!table->wildcards.empty()) {
+        for (size_t type_id = table->resolved_types; type_id < type_count; ++type_id) {
+            const std::string& type = event_type_registry().name(static_cast<EventTypeId>(type_id));
+            for (const auto& wildcard : table->wildcards) {
+                if (matches_prefix(type, wildcard.prefix)) {
+                    rebuild_list(*table, static_cast<EventTypeId>(type_id));
+                    break;
+                }
+            }
+        }
+    }
+    table->resolved_types = type_count;
+    return table;
+}
+
+void EventDispatcher::commit_table(std::unique_ptr<HandlerTable> table) {
+    size_t resolved = table->wildcards.empty() ? SIZE_MAX : table->resolved_types;
+    handlers_.publish(std::move(table));
+    resolved_types_.store(resolved, std::memory_order_release);
+}
+
+void EventDispatcher::rebuild_list(HandlerTable& table, EventTypeId type_id) {
+    const std::string& type = event_type_registry().name(type_id);
+    auto handler_list = std::make_shared<HandlerList>();
+
+    if (type_id < table.lists.size() && table.lists[type_id]) {
+        for (const auto& entry : *table.lists[type_id]) {
+            if (!entry.wildcard && !entry.removed()) handler_list->push_back(entry);
+        }
+    }
+    for (const auto& wildcard : table.wildcards) {
+        if (!wildcard.entry.removed() && matches_prefix(type, wildcard.prefix)) {
+            handler_list->push_back(wildcard.entry);
+        }
+    }
+
+    // Same order as add_entry produces: priority first, newer subscriptions before older ones
+    std::sort(handler_list->begin(), handler_list->end(),
+        [](const HandlerEntry& a, const HandlerEntry& b) {
+            return a.priority != b.priority ? a.priority > b.priority : a.sequence > b.sequence;
+        });
+
+    if (type_id >= table.lists.size()) {
+        if (handler_list->empty()) return;
+        table.lists.resize(static_cast<size_t>(type_id) + 1);
+    }
+    table.lists[type_id] = handler_list->empty() ? nullptr : std::move(handler_list);
+}
+
+void EventDispatcher::rebuild_matching(HandlerTable& table, const std::string& prefix) {
+    for (size_t type_id = 0; type_id < table.resolved_types; ++type_id) {
+        if (matches_prefix(event_type_registry().name(static_cast<EventTypeId>(type_id)), prefix)) {
+            rebuild_list(table, static_cast<EventTypeId>(type_id));
+        }
+    }
+}
+
+void EventDispatcher::resolve_new_types() {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    if (handlers_.writer_view().resolved_types >= event_type_registry().size()) return;
+    commit_table(copy_table());
+}
+
+HandlerId EventDispatcher::allocate_handle(EventTypeId type_id, bool wildcard, const std::string& prefix,
+                                           const std::shared_ptr<Subscription>& subscription) {
+    uint32_t index;
+    if (!free_handles_.empty()) {
+        index = free_handles_.back();
+        free_handles_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(handles_.size());
+        handles_.emplace_back();
+    }
+
+    HandleSlot& slot = handles_[index];
+    slot.type_id = type_id;
+    slot.wildcard = wildcard;
+    slot.prefix = prefix;
+    slot.subscription = subscription;
+    ++live_handles_;
+    return (static_cast<HandlerId>(slot.generation) << 32) | index;
+}
+
+EventDispatcher::HandleSlot* EventDispatcher::find_handle(HandlerId id) {
+    const size_t index = id & 0xffffffffu;
+    if (index >= handles_.size()) return nullptr;
+    HandleSlot& slot = handles_[index];
+    if (!slot.subscription || slot.generation != static_cast<uint32_t>(id >> 32)) return nullptr;
+    return &slot;
+}
+
+void EventDispatcher::release_handle(HandlerId id) {
+    HandleSlot* slot = find_handle(id);
+    if (!slot) return;
+
+    // Running dispatches skip the entry from now on; compaction drops it from the lists
+    slot->subscription->removed.store(true, std::memory_order_relaxed);
+    slot->subscription.reset();
+    slot->prefix.clear();
+    if (++slot->generation == 0) slot->generation = 1;  // Zero would allow a null HandlerId
+    free_handles_.push_back(static_cast<uint32_t>(id & 0xffffffffu));
+    --live_handles_;
+    tombstones_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventDispatcher::compact_if_needed() {
+    // Compaction costs O(total entries), so wait until tombstones are as many as live handlers
+    if (tombstones_.load(std::memory_order_relaxed) >= std::max<size_t>(MIN_COMPACTION, live_handles_)) {
+        compact();
+    }
+}
+
+void EventDispatcher::compact() {
+    auto table = copy_table();
+    for (auto& handler_list : table->lists) {
+        if (!handler_list) continue;
+        if (std::none_of(handler_list->begin(), handler_list->end(),
+                [](const HandlerEntry& entry) { return entry.removed(); })) {
+            continue;
+        }
+
+        auto remaining = std::make_shared<HandlerList>();
+        std::copy_if(handler_list->begin(), handler_list->end(), std::back_inserter(*remaining),
+            [](const HandlerEntry& entry) { return !entry.removed(); });
+        handler_list = remaining->empty() ? nullptr : std::move(remaining);
     }
+    std::erase_if(table->wildcards, [](const WildcardEntry& wildcard) { return wildcard.entry.removed(); });
+    commit_table(std::move(table));
+    tombstones_.store(0, std::memory_order_relaxed);
+}
+
+void EventDispatcher::unsubscribe(HandlerId id) {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    release_handle(id);
+    compact_if_needed();
 }
 
 void EventDispatcher::unsubscribe(const std::string& event_type, HandlerId id) {
-    auto it = handlers_.find(event_type);
-    if (it != handlers_.end()) {
-        auto& handler_list = it->second;
-        auto remove_it = std::remove_if(handler_list.begin(), handler_list.end(),
-            [id](const HandlerEntry& entry) { return entry.id == id; });
-        handler_list.erase(remove_it, handler_list.end());
+    if (is_pattern(event_type)) {
+        std::string prefix = pattern_prefix(event_type);
+        std::lock_guard<std::mutex> lock(handlers_mutex_);
+        HandleSlot* slot = find_handle(id);
+        if (slot && slot->wildcard && slot->prefix == prefix) {
+            release_handle(id);
+            compact_if_needed();
+        }
+        return;
+    }
+    if (auto type_id = event_type_registry().find(event_type)) {
+        unsubscribe(*type_id, id);
+    }
+}
+
+void EventDispatcher::unsubscribe(EventTypeId type_id, HandlerId id) {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    HandleSlot* slot = find_handle(id);
+    if (slot && !slot->wildcard && slot->type_id == type_id) {
+        release_handle(id);
+        compact_if_needed();
     }
 }
 
 void EventDispatcher::unsubscribe_all(const std::string& event_type) {
-    handlers_.erase(event_type);
+    if (is_pattern(event_type)) {
+        std::string prefix = pattern_prefix(event_type);
+        std::lock_guard<std::mutex> lock(handlers_mutex_);
+        for (const auto& wildcard : handlers_.writer_view().wildcards) {
+            if (wildcard.prefix == prefix) release_handle(wildcard.entry.id);
+        }
+        compact_if_needed();
+        return;
+    }
+    if (auto type_id = event_type_registry().find(event_type)) {
+        unsubscribe_all(*type_id);
+    }
+}
+
+void EventDispatcher::unsubscribe_all(EventTypeId type_id) {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    const HandlerTable& current = handlers_.writer_view();
+    if (type_id >= current.lists.size() || !current.lists[type_id]) return;
+
+    // Wildcard subscriptions matching this type stay in place
+    for (const auto& entry : *current.lists[type_id]) {
+        if (!entry.wildcard) release_handle(entry.id);
+    }
+    compact_if_needed();
 }
 
 void EventDispatcher::clear() {
-    handlers_.clear();
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    while (!event_queue_.empty()) {
-        event_queue_.pop();
+    {
+        std::lock_guard<std::mutex> lock(handlers_mutex_);
+        for (uint32_t index = 0; index < handles_.size(); ++index) {
+            HandleSlot& slot = handles_[index];
+            if (slot.subscription) {
+                release_handle((static_cast<HandlerId>(slot.generation) << 32) | index);
+            }
+        }
+        commit_table(std::make_unique<HandlerTable>());
+        tombstones_.store(0, std::memory_order_relaxed);
     }
+    for (auto& queue : queues_) {
+        queue->clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(coalesce_mutex_);
+        coalesce_index_.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    timers_.clear();
+    timer_count_.store(0, std::memory_order_release);
 }
 
 void EventDispatcher::dispatch(Event& event) {
-    auto it = handlers_.find(event.type());
-    if (it == handlers_.end()) return;
+    if (DispatcherMetrics* metrics = metrics_.load(std::memory_order_acquire)) {
+        dispatch_measured(event, *metrics, false);
+        return;
+    }
+    if (observing_.load(std::memory_order_acquire)) {
+        notify_observers(event);
+    }
 
-    for (auto& entry : it->second) {
+    EventTypeId type_id = event.type_id();
+    resolve_wildcards(type_id);
+    auto table = handlers_.read();
+    if (type_id >= table->lists.size() || !table->lists[type_id]) {
+        if (waiting_.load(std::memory_order_relaxed) > 0) resume_waiters(event);
+        return;
+    }
+
+    const HandlerList& handler_list = *table->lists[type_id];
+    FanOutPool* fan_out = fan_out_.get();
+    for (size_t i = 0; i < handler_list.size(); ++i) {
         if (event.is_handled()) break;
-        entry.handler(event);
+        const Subscription& subscription = *handler_list[i].subscription;
+        if (subscription.removed.load(std::memory_order_relaxed)) continue;
+        if (subscription.parallel_safe && fan_out) {
+            i = dispatch_tier(handler_list, i, event, *fan_out) - 1;
+        } else if (subscription.batch_handler) {
+            Event* single = &event;
+            subscription.batch_handler(std::span<Event* const>(&single, 1));
+        } else {
+            subscription.handler(event);
+        }
+    }
+    if (waiting_.load(std::memory_order_relaxed) > 0) resume_waiters(event);
+}
+
+void EventDispatcher::dispatch_measured(Event& event, DispatcherMetrics& metrics, bool queued) {
+    using Clock = DispatcherMetrics::Clock;
+
+    if (observing_.load(std::memory_order_acquire)) {
+        notify_observers(event);
+    }
+
+    EventTypeId type_id = event.type_id();
+    resolve_wildcards(type_id);
+    auto table = handlers_.read();
+    const bool sampled = metrics.should_sample();
+    const Clock::time_point start = sampled ? Clock::now() : Clock::time_point();
+    if (sampled && queued) {
+        metrics.record_queue_wait(type_id, DispatcherMetrics::elapsed_ns(event.timestamp(), start));
+    }
+
+    // Each handler is timed from the end of the previous one: one clock read per handler
+    Clock::time_point last = start;
+    if (type_id < table->lists.size() && table->lists[type_id]) {
+        const HandlerList& handler_list = *table->lists[type_id];
+        FanOutPool* fan_out = fan_out_.get();
+        for (size_t i = 0; i < handler_list.size(); ++i) {
+            if (event.is_handled()) break;
+            const HandlerEntry& entry = handler_list[i];
+            const Subscription& subscription = *entry.subscription;
+            if (subscription.removed.load(std::memory_order_relaxed)) continue;
+            if (subscription.parallel_safe && fan_out) {
+                // The tier's handlers overlap, so they are counted but not timed
+                size_t end = dispatch_tier(handler_list, i, event, *fan_out);
+                for (; i < end; ++i) {
+                    if (handler_list[i].removed()) continue;  // Unsubscribed since the table was read
+                    metrics.record_handler(type_id, handler_list[i].id, false, 0);
+                }
+                --i;
+                if (sampled) last = Clock::now();
+                continue;
+            }
+            if (subscription.batch_handler) {
+                Event* single = &event;
+                subscription.batch_handler(std::span<Event* const>(&single, 1));
+            } else {
+                subscription.handler(event);
+            }
+
+            if (sampled) {
+                Clock::time_point now = Clock::now();
+                metrics.record_handler(type_id, entry.id, true, DispatcherMetrics::elapsed_ns(last, now));
+                last = now;
+            } else {
+                metrics.record_handler(type_id, entry.id, false, 0);
+            }
+        }
+    }
+    metrics.record_dispatch(type_id, 1, sampled, DispatcherMetrics::elapsed_ns(start, last));
+    if (waiting_.load(std::memory_order_relaxed) > 0) resume_waiters(event);
+}
+
+size_t EventDispatcher::dispatch_tier(const HandlerList& handler_list, size_t first, Event& event,
+                                     FanOutPool& fan_out) {
+    const int priority = handler_list[first].priority;
+    size_t end = first;
+    size_t parallel = 0;
+    size_t first_serial = SIZE_MAX;
+    for (; end < handler_list.size() && handler_list[end].priority == priority; ++end) {
+        if (handler_list[end].subscription->parallel_safe) {
+            ++parallel;
+        } else if (first_serial == SIZE_MAX) {
+            first_serial = end;
+        }
+    }
+
+    // Parallel-safe handlers each get a task; the rest of the tier keeps its order in one task
+    auto task = [&](size_t offset) {
+        const size_t index = first + offset;
+        const Subscription& subscription = *handler_list[index].subscription;
+        if (subscription.parallel_safe) {
+            if (!subscription.removed.load(std::memory_order_relaxed)) subscription.handler(event);
+        } else if (index == first_serial) {
+            for (size_t i = index; i < end; ++i) {
+                const Subscription& serial = *handler_list[i].subscription;
+                if (serial.parallel_safe || serial.removed.load(std::memory_order_relaxed)) continue;
+                if (serial.batch_handler) {
+                    Event* single = &event;
+                    serial.batch_handler(std::span<Event* const>(&single, 1));
+                } else {
+                    serial.handler(event);
+                }
+            }
+        }
+    };
+    if (parallel > 1) {
+        fan_out.run(end - first, task);
+        return end;
+    }
+
+    // Nothing to overlap: plain in-order dispatch of the tier
+    for (size_t i = first; i < end && !event.is_handled(); ++i) {
+        const Subscription& subscription = *handler_list[i].subscription;
+        if (subscription.removed.load(std::memory_order_relaxed)) continue;
+        if (subscription.batch_handler) {
+            Event* single = &event;
+            subscription.batch_handler(std::span<Event* const>(&single, 1));
+        } else {
+            subscription.handler(event);
+        }
     }
+    return end;
+}
+
+void EventDispatcher::dispatch_batch(std::span<Event* const> events) {
+    dispatch_grouped(events, false);
+}
+
+void EventDispatcher::dispatch_grouped(std::span<Event* const> events, bool queued) {
+    if (events.empty()) return;
+
+    if (observing_.load(std::memory_order_acquire)) {
+        for (Event* event : events) {
+            notify_observers(*event);
+        }
+    }
+
+    std::vector<Event*> grouped(events.begin(), events.end());
+    std::stable_sort(grouped.begin(), grouped.end(),
+        [](const Event* a, const Event* b) { return a->type_id() < b->type_id(); });
+
+    resolve_wildcards(grouped.back()->type_id());  // Highest type ID of the batch
+    DispatcherMetrics* metrics = metrics_.load(std::memory_order_acquire);
+    auto table = handlers_.read();
+    std::vector<Event*> live;
+    live.reserve(grouped.size());
+
+    auto first = grouped.begin();
+    while (first != grouped.end()) {
+        EventTypeId type_id = (*first)->type_id();
+        auto last = std::find_if(first, grouped.end(),
+            [type_id](const Event* event) { return event->type_id() != type_id; });
+
+        std::span<Event* const> group(&*first, last - first);
+        const HandlerList* handler_list =
+            type_id < table->lists.size() ? table->lists[type_id].get() : nullptr;
+        if (metrics) {
+            static const HandlerList no_handlers;
+            dispatch_group_measured(handler_list ? *handler_list : no_handlers, group, live, *metrics,
+                                    queued);
+        } else if (handler_list) {
+            dispatch_group(*handler_list, group, live);
+        }
+        if (waiting_.load(std::memory_order_relaxed) > 0) {
+            for (Event* event : group) resume_waiters(*event);
+        }
+        first = last;
+    }
+}
+
+void EventDispatcher::dispatch_group(const HandlerList& handler_list, std::span<Event* const> group,
+                                     std::vector<Event*>& live) {
+    for (const auto& entry : handler_list) {
+        const Subscription& subscription = *entry.subscription;
+        if (subscription.removed.load(std::memory_order_relaxed)) continue;
+        if (subscription.batch_handler) {
+            // Batch handlers only see events no earlier handler marked as handled
+            live.clear();
+            for (Event* event : group) {
+                if (!event->is_handled()) live.push_back(event);
+            }
+            if (!live.empty()) {
+                subscription.batch_handler(std::span<Event* const>(live));
+            }
+        } else {
+            for (Event* event : group) {
+                if (!event->is_handled()) subscription.handler(*event);
+            }
+        }
+    }
+}
+
+void EventDispatcher::dispatch_group_measured(const HandlerList& handler_list,
+                                              std::span<Event* const> group, std::vector<Event*>& live,
+                                              DispatcherMetrics& metrics, bool queued) {
+    using Clock = DispatcherMetrics::Clock;
+
+    // One sampling decision and one queue-wait clock read per type group
+    EventTypeId type_id = group.front()->type_id();
+    const bool sampled = metrics.should_sample();
+    const Clock::time_point start = sampled ? Clock::now() : Clock::time_point();
+    if (sampled && queued) {
+        for (Event* event : group) {
+            metrics.record_queue_wait(type_id, DispatcherMetrics::elapsed_ns(event->timestamp(), start));
+        }
+    }
+
+    Clock::time_point last = start;
+    auto record = [&](HandlerId id) {
+        if (sampled) {
+            Clock::time_point now = Clock::now();
+            metrics.record_handler(type_id, id, true, DispatcherMetrics::elapsed_ns(last, now));
+            last = now;
+        } else {
+            metrics.record_handler(type_id, id, false, 0);
+        }
+    };
+
+    for (const auto& entry : handler_list) {
+        const Subscription& subscription = *entry.subscription;
+        if (subscription.removed.load(std::memory_order_relaxed)) continue;
+        if (subscription.batch_handler) {
+            live.clear();
+            for (Event* event : group) {
+                if (!event->is_handled()) live.push_back(event);
+            }
+            if (!live.empty()) {
+                subscription.batch_handler(std::span<Event* const>(live));
+                record(entry.id);
+            }
+        } else {
+            for (Event* event : group) {
+                if (event->is_handled()) continue;
+                subscription.handler(*event);
+                record(entry.id);
+            }
+        }
+    }
+    metrics.record_dispatch(type_id, group.size(), sampled, DispatcherMetrics::elapsed_ns(start, last));
+}
+
+void EventDispatcher::dispatch_events(std::span<Event* const> events) {
+    // Coalescing placeholders hand over the event their key ended up with
+    const EventTypeId placeholder = coalesced_type().id;
+    auto first = std::find_if(events.begin(), events.end(),
+        [placeholder](const Event* event) { return event->type_id() == placeholder; });
+    if (first != events.end()) {
+        std::vector<std::unique_ptr<Event>> owned;
+        std::vector<Event*> resolved(events.begin(), first);
+        for (auto it = first; it != events.end(); ++it) {
+            if ((*it)->type_id() != placeholder) {
+                resolved.push_back(*it);
+            } else if (auto event = take_coalesced(static_cast<CoalescedEvent&>(**it))) {
+                resolved.push_back(event.get());
+                owned.push_back(std::move(event));
+            }
+        }
+        dispatch_events_resolved(resolved);
+        return;
+    }
+    dispatch_events_resolved(events);
+}
+
+void EventDispatcher::dispatch_events_resolved(std::span<Event* const> events) {
+    if (batch_dispatch_.load(std::memory_order_relaxed)) {
+        dispatch_grouped(events, true);
+        return;
+    }
+    if (DispatcherMetrics* metrics = metrics_.load(std::memory_order_acquire)) {
+        for (Event* event : events) {
+            dispatch_measured(*event, *metrics, true);
+        }
+        return;
+    }
+    for (Event* event : events) {
+        dispatch(*event);
+    }
+}
+
+void EventDispatcher::set_batch_dispatch(bool enabled) {
+    batch_dispatch_.store(enabled, std::memory_order_relaxed);
+}
+
+bool EventDispatcher::batch_dispatch() const {
+    return batch_dispatch_.load(std::memory_order_relaxed);
 }
 
 void EventDispatcher::dispatch_immediate(Event& event) {
     dispatch(event);
 }
 
-void EventDispatcher::queue_event(std::unique_ptr<Event> event) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    event_queue_.push(std::move(event));
+bool EventDispatcher::queue_event(std::unique_ptr<Event> event) {
+    EventLane lane = lane_routing_.load(std::memory_order_acquire) ? lane_for(event->type_id())
+                                                                    : EventLane::Normal;
+    return queue_event(std::move(event), lane);
+}
+
+bool EventDispatcher::queue_event(std::unique_ptr<Event> event, EventLane lane) {
+    std::shared_ptr<CoalesceSlot> opened;
+    if (coalescing_enabled_.load(std::memory_order_acquire) && coalesce(event, opened)) {
+        return true;
+    }
+    EventTypeId route = routed_type(*event);
+    bool queued = workers_ ? workers_->submit(std::move(event), route) : lane_queue(lane).push(std::move(event));
+    if (queued && opened) {
+        open_coalesce_slot(opened);
+    }
+    record_queue_depth();
+    return queued;
+}
+
+bool EventDispatcher::try_queue_event(std::unique_ptr<Event>& event) {
+    EventLane lane = lane_routing_.load(std::memory_order_acquire) ? lane_for(event->type_id())
+                                                                    : EventLane::Normal;
+    std::shared_ptr<CoalesceSlot> opened;
+    if (coalescing_enabled_.load(std::memory_order_acquire) && coalesce(event, opened)) {
+        return true;
+    }
+    bool queued = workers_ ? workers_->try_submit(event, routed_type(*event)) : lane_queue(lane).try_push(event);
+    if (opened) {
+        if (queued) {
+            open_coalesce_slot(opened);
+        } else {
+            // Nobody else saw the slot yet; hand the caller its event back
+            event = std::move(opened->pending);
+        }
+    }
+    if (queued) {
+        record_queue_depth();
+    }
+    return queued;
+}
+
+EventQueue& EventDispatcher::lane_queue(EventLane lane) {
+    return *queues_[static_cast<size_t>(lane)];
+}
+
+void EventDispatcher::record_queue_depth() {
+    if (DispatcherMetrics* metrics = metrics_.load(std::memory_order_acquire)) {
+        size_t depth = 0;
+        if (workers_) {
+            depth = workers_->pending();
+        } else {
+            for (const auto& queue : queues_) {
+                depth += queue->size();
+            }
+        }
+        metrics->record_queue_depth(depth);
+    }
 }
 
 void EventDispatcher::process_queue() {
-    std::queue<std::unique_ptr<Event>> local_queue;
+    drain_queues(nullptr);
+    compact_after_dispatch();
+}
+
+void EventDispatcher::process_queue(std::chrono::steady_clock::duration max_duration) {
+    auto deadline = std::chrono::steady_clock::now() + max_duration;
+    drain_queues(&deadline);
+    compact_after_dispatch();
+}
+
+void EventDispatcher::compact_after_dispatch() {
+    // Never wait for a subscriber here; the next call will try again
+    if (tombstones_.load(std::memory_order_relaxed) == 0) return;
+    std::unique_lock<std::mutex> lock(handlers_mutex_, std::try_to_lock);
+    if (lock.owns_lock() && tombstones_.load(std::memory_order_relaxed) > 0) {
+        compact();
+    }
+}
+
+void EventDispatcher::drain_queues(const std::chrono::steady_clock::time_point* deadline) {
+    EventQueue::ConsumerScope consumer;  // Handlers queueing into a full Block lane fail instead of waiting
+    tick();
+
+    if (workers_) {
+        // Hand over anything queued before the workers started
+        for (auto& queue : queues_) {
+            while (auto event = queue->pop()) {
+                EventTypeId route = routed_type(*event);
+                workers_->submit(std::move(event), route);
+            }
+        }
+        return;
+    }
 
+    // Only drain what is pending now; events queued by handlers wait for the next call
+    std::array<size_t, LANE_COUNT> remaining;
+    std::array<size_t, LANE_COUNT> chunk;
+    size_t total = 0;
+    size_t max_weight = 1;
+    for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+        remaining[lane] = queues_[lane]->size();
+        total += remaining[lane];
+        chunk[lane] = lane_weights_[lane].load(std::memory_order_relaxed);
+        max_weight = std::max(max_weight, chunk[lane]);
+    }
+    if (!deadline) {
+        // Without a budget the weights only set the interleaving; drain in full batches
+        const size_t batch_size = std::max<size_t>(queues_[0]->config().batch_size, 1);
+        for (auto& size : chunk) {
+            size = std::max<size_t>(1, batch_size * size / max_weight);
+        }
+    }
+
+    std::vector<std::unique_ptr<Event>> batch;
+    std::vector<Event*> events;
+    bool out_of_time = false;
+
+    while (total > 0 && !out_of_time) {
+        for (size_t lane = 0; lane < LANE_COUNT && !out_of_time; ++lane) {
+            if (remaining[lane] == 0) continue;
+
+            size_t count = queues_[lane]->pop_batch(batch, std::min(remaining[lane], chunk[lane]));
+            if (count == 0) {
+                // Drained by a concurrent consumer or DropOldest
+                total -= remaining[lane];
+                remaining[lane] = 0;
+                continue;
+            }
+            remaining[lane] -= count;
+            total -= count;
+
+            for (auto& event : batch) {
+                events.push_back(event.get());
+            }
+            dispatch_events(events);
+            events.clear();
+            batch.clear();
+
+            out_of_time = deadline && std::chrono::steady_clock::now() >= *deadline;
+        }
+    }
+}
+
+TimerId EventDispatcher::schedule_event(std::unique_ptr<Event> event, TimerWheel::Duration delay) {
+    if (!event) {
+        throw std::invalid_argument("Cannot schedule a null event");
+    }
+    return add_timer(TimerTask{std::move(event), nullptr}, delay, TimerWheel::Duration::zero());
+}
+
+TimerId EventDispatcher::schedule_periodic(EventFactory factory, TimerWheel::Duration interval) {
+    if (!factory) {
+        throw std::invalid_argument("Periodic event factory is empty");
+    }
+    if (interval <= TimerWheel::Duration::zero()) {
+        throw std::invalid_argument("Periodic interval must be positive");
+    }
+    auto callback = std::make_shared<const TimerCallback>([this, factory = std::move(factory)] {
+        if (auto event = factory()) {
+            queue_event(std::move(event));
+        }
+    });
+    return add_timer(TimerTask{nullptr, std::move(callback)}, interval, interval);
+}
+
+TimerId EventDispatcher::schedule_callback(TimerCallback callback, TimerWheel::Duration delay,
+                                           TimerWheel::Duration period) {
+    if (!callback) {
+        throw std::invalid_argument("Timer callback is empty");
+    }
+    return add_timer(TimerTask{nullptr, std::make_shared<const TimerCallback>(std::move(callback))},
+                     delay, period);
+}
+
+TimerId EventDispatcher::add_timer(TimerTask task, TimerWheel::Duration delay, TimerWheel::Duration period) {
+    auto now = TimerWheel::Clock::now();
+    auto deadline = now + std::max(delay, TimerWheel::Duration::zero());
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    if (timers_.empty()) {
+        // tick() leaves an empty wheel alone, so it may lag far behind; catch
+        // it up in one jump now, before a timer makes advance() walk the gap
+        std::vector<TimerTask> none;
+        timers_.advance(now, none);
+    }
+    TimerId id = timers_.schedule(deadline, std::move(task), period);
+    timer_count_.store(timers_.size(), std::memory_order_release);
+    return id;
+}
+
+bool EventDispatcher::cancel_timer(TimerId id) {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    bool cancelled = timers_.cancel(id);
+    timer_count_.store(timers_.size(), std::memory_order_release);
+    return cancelled;
+}
+
+size_t EventDispatcher::tick() {
+    if (timer_count_.load(std::memory_order_acquire) == 0) return 0;
+
+    EventQueue::ConsumerScope consumer;
+    std::vector<TimerTask> expired;
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        std::swap(local_queue, event_queue_);
+        std::lock_guard<std::mutex> lock(timers_mutex_);
+        timers_.advance(TimerWheel::Clock::now(), expired);
+        timer_count_.store(timers_.size(), std::memory_order_release);
     }
 
-    while (!local_queue.empty()) {
-        auto event = std::move(local_queue.front());
-        local_queue.pop();
-        dispatch(*event);
+    // Fired outside the lock so callbacks can schedule or cancel timers
+    for (auto& task : expired) {
+        if (task.event) {
+            queue_event(std::move(task.event));
+        } else {
+            (*task.callback)();
+        }
+    }
+    return expired.size();
+}
+
+size_t EventDispatcher::pending_timers() const {
+    return timer_count_.load(std::memory_order_acquire);
+}
+
+bool EventDispatcher::coalesce(std::unique_ptr<Event>& event, std::shared_ptr<CoalesceSlot>& opened) {
+    EventTypeId type_id = event->type_id();
+    std::shared_ptr<const CoalescePolicy> policy;
+    {
+        auto table = coalesce_policies_.read();
+        if (type_id >= table->policies.size() || !table->policies[type_id]) return false;
+        policy = table->policies[type_id];
+    }
+
+    if (policy->mode == CoalesceMode::KeepAll) return false;
+    bool coalescing = !policy->filter || policy->filter(*event);
+    uint64_t key = coalescing && policy->key ? policy->key(*event) : 0;
+
+    std::unique_ptr<Event> superseded;  // Destroyed after the lock is released
+    std::lock_guard<std::mutex> lock(coalesce_mutex_);
+
+    if (!coalescing) {
+        // Queued behind the type's pending placeholders as usual; close their
+        // slots so later events of the type are not folded in ahead of it
+        coalesce_index_.erase(coalesce_index_.lower_bound({type_id, 0}),
+                              coalesce_index_.upper_bound({type_id, UINT64_MAX}));
+        return false;
+    }
+
+    auto it = coalesce_index_.find({type_id, key});
+    if (it == coalesce_index_.end() || it->second->closed.load(std::memory_order_relaxed)) {
+        // First event of the key: queue a placeholder that holds it. The slot
+        // is only opened to later events once the placeholder is queued
+        opened = std::make_shared<CoalesceSlot>();
+        opened->key = {type_id, key};
+        opened->pending = std::move(event);
+        event = std::make_unique<CoalescedEvent>(opened);
+        return false;
+    }
+
+    CoalesceSlot& slot = *it->second;
+    if (policy->mode == CoalesceMode::Merge) {
+        policy->merge(*slot.pending, *event);
+        superseded = std::move(event);
+    } else {
+        superseded = std::exchange(slot.pending, std::move(event));
+    }
+    coalesced_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void EventDispatcher::open_coalesce_slot(const std::shared_ptr<CoalesceSlot>& slot) {
+    std::lock_guard<std::mutex> lock(coalesce_mutex_);
+    // Already dispatched or evicted; or another producer opened one meanwhile
+    if (slot->closed.load(std::memory_order_relaxed) || !slot->pending) return;
+    auto [type_id, key] = slot->key;
+    auto [it, inserted] = coalesce_index_.try_emplace({type_id, key}, slot);
+    if (!inserted && it->second->closed.load(std::memory_order_relaxed)) {
+        it->second = slot;
+    }
+}
+
+EventTypeId EventDispatcher::routed_type(const Event& event) {
+    // Workers keep a type in order by its lane, so placeholders go with their type
+    if (event.type_id() == coalesced_type().id) {
+        return static_cast<const CoalescedEvent&>(event).slot()->key.first;
+    }
+    return event.type_id();
+}
+
+std::unique_ptr<Event> EventDispatcher::take_coalesced(CoalescedEvent& placeholder) {
+    const std::shared_ptr<CoalesceSlot>& slot = placeholder.slot();
+    std::lock_guard<std::mutex> lock(coalesce_mutex_);
+    slot->closed.store(true, std::memory_order_relaxed);
+    auto it = coalesce_index_.find(slot->key);
+    if (it != coalesce_index_.end() && it->second == slot) {
+        coalesce_index_.erase(it);
+    }
+    return std::move(slot->pending);
+}
+
+void EventDispatcher::set_coalescing(const std::string& event_type, CoalescePolicy policy) {
+    set_coalescing(event_type_registry().intern(event_type), std::move(policy));
+}
+
+void EventDispatcher::set_coalescing(EventTypeId type_id, CoalescePolicy policy) {
+    if (policy.mode == CoalesceMode::Merge && !policy.merge) {
+        throw std::invalid_argument("Merge coalescing needs a merge function");
+    }
+    std::lock_guard<std::mutex> lock(coalesce_mutex_);
+    auto table = std::make_unique<CoalesceTable>(coalesce_policies_.writer_view());
+    if (type_id >= table->policies.size()) {
+        table->policies.resize(static_cast<size_t>(type_id) + 1);
+    }
+    table->policies[type_id] = std::make_shared<const CoalescePolicy>(std::move(policy));
+    coalesce_policies_.publish(std::move(table));
+    coalescing_enabled_.store(true, std::memory_order_release);
+}
+
+void EventDispatcher::clear_coalescing() {
+    std::lock_guard<std::mutex> lock(coalesce_mutex_);
+    coalescing_enabled_.store(false, std::memory_order_release);
+    coalesce_policies_.publish(std::make_unique<CoalesceTable>());
+}
+
+size_t EventDispatcher::coalesced_events() const {
+    return coalesced_.load(std::memory_order_relaxed);
+}
+
+void EventDispatcher::set_lane(const std::string& event_type, EventLane lane) {
+    set_lane(event_type_registry().intern(event_type), lane);
+}
+
+void EventDispatcher::set_lane(EventTypeId type_id, EventLane lane) {
+    std::lock_guard<std::mutex> lock(lanes_mutex_);
+    auto table = std::make_unique<LaneTable>(lane_table_.writer_view());
+    if (type_id >= table->lanes.size()) {
+        table->lanes.resize(static_cast<size_t>(type_id) + 1, EventLane::Normal);
     }
+    table->lanes[type_id] = lane;
+    lane_table_.publish(std::move(table));
+    lane_routing_.store(true, std::memory_order_release);
+}
+
+EventLane EventDispatcher::lane_for(EventTypeId type_id) const {
+    auto table = lane_table_.read();
+    return type_id < table->lanes.size() ? table->lanes[type_id] : EventLane::Normal;
+}
+
+void EventDispatcher::set_lane_weights(size_t critical, size_t normal, size_t bulk) {
+    if (critical == 0 || normal == 0 || bulk == 0) {
+        throw std::invalid_argument("Lane weights must be positive");
+    }
+    lane_weights_[static_cast<size_t>(EventLane::Critical)].store(critical, std::memory_order_relaxed);
+    lane_weights_[static_cast<size_t>(EventLane::Normal)].store(normal, std::memory_order_relaxed);
+    lane_weights_[static_cast<size_t>(EventLane::Bulk)].store(bulk, std::memory_order_relaxed);
+}
+
+size_t EventDispatcher::pending_events(EventLane lane) const {
+    return queues_[static_cast<size_t>(lane)]->size();
 }
 
 size_t EventDispatcher::pending_events() const {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    return event_queue_.size();
+    size_t pending = 0;
+    for (const auto& queue : queues_) {
+        pending += queue->size();
+    }
+    if (workers_) {
+        pending += workers_->pending();
+    }
+    return pending;
+}
+
+size_t EventDispatcher::dropped_events() const {
+    size_t dropped = retired_dropped_.load(std::memory_order_relaxed);
+    for (const auto& queue : queues_) {
+        dropped += queue->dropped();
+    }
+    return dropped;
+}
+
+void EventDispatcher::configure_queue(const QueueConfig& config) {
+    for (auto& current : queues_) {
+        auto queue = std::make_unique<EventQueue>(config);
+        size_t lost = current->dropped();
+        while (auto event = current->pop()) {
+            if (!queue->try_push(event)) {
+                // Everything from here on no longer fits
+                ++lost;
+                while (current->pop()) {
+                    ++lost;
+                }
+                break;
+            }
+        }
+        retired_dropped_.fetch_add(lost, std::memory_order_relaxed);
+        current = std::move(queue);
+    }
+}
+
+const QueueConfig& EventDispatcher::queue_config() const {
+    return queues_[0]->config();
+}
+
+EventPool::Stats EventDispatcher::event_pool_stats() {
+    return EventPool::instance().stats();
+}
+
+void EventDispatcher::start_workers(size_t thread_count) {
+    stop_workers(true);
+    workers_ = std::make_unique<DispatchWorkerPool>(thread_count, queue_config(),
+        [this](std::span<Event* const> events) { dispatch_events(events); });
+    process_queue();
+}
+
+void EventDispatcher::stop_workers(bool drain_pending) {
+    if (workers_) {
+        workers_->shutdown(drain_pending);
+        workers_.reset();
+    }
+}
+
+void EventDispatcher::drain() {
+    if (workers_) {
+        process_queue();
+        workers_->drain();
+    } else {
+        while (pending_events() > 0) {
+            process_queue();
+        }
+    }
+}
+
+bool EventDispatcher::workers_running() const {
+    return workers_ != nullptr;
+}
+
+void EventDispatcher::start_fan_out(size_t thread_count) {
+    stop_fan_out();
+    if (thread_count > 0) {
+        fan_out_ = std::make_unique<FanOutPool>(thread_count);
+    }
+}
+
+void EventDispatcher::stop_fan_out() {
+    fan_out_.reset();
+}
+
+size_t EventDispatcher::fan_out_threads() const {
+    return fan_out_ ? fan_out_->thread_count() : 0;
+}
+
+size_t EventDispatcher::worker_count() const {
+    return workers_ ? workers_->thread_count() : 0;
+}
+
+void EventDispatcher::add_waiter(EventWaiter& waiter) {
+    std::lock_guard<std::mutex> lock(waiters_mutex_);
+    if (waiter.type_id_ >= waiter_lists_.size()) {
+        waiter_lists_.resize(static_cast<size_t>(waiter.type_id_) + 1);
+    }
+    link_waiter(waiter_lists_[waiter.type_id_], waiter);
+    waiter.state_ = EventWaiter::State::Waiting;
+    waiting_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventDispatcher::remove_waiter(EventWaiter& waiter) {
+    std::lock_guard<std::mutex> lock(waiters_mutex_);
+    if (waiter.state_ == EventWaiter::State::Waiting) {
+        waiting_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (waiter.state_ == EventWaiter::State::Waiting || waiter.state_ == EventWaiter::State::Firing) {
+        unlink_waiter(waiter);
+    }
+    waiter.state_ = EventWaiter::State::Idle;
+}
+
+void EventDispatcher::resume_waiters(Event& event) {
+    const EventTypeId type_id = event.type_id();
+    WaiterLink firing;
+
+    // Waiters that did not get resumed go back to waiting, e.g. when a filter throws
+    auto restore = [&] {
+        std::lock_guard<std::mutex> lock(waiters_mutex_);
+        while (firing.next != &firing) {
+            WaiterLink& link = *firing.next;
+            unlink_waiter(link);
+            link_waiter(waiter_lists_[type_id], link);
+            static_cast<EventWaiter&>(link).state_ = EventWaiter::State::Waiting;
+            waiting_.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    try {
+        {
+            std::lock_guard<std::mutex> lock(waiters_mutex_);
+            if (type_id >= waiter_lists_.size()) return;
+
+            WaiterLink& list = waiter_lists_[type_id];
+            for (WaiterLink* link = list.next; link != &list;) {
+                WaiterLink* next = link->next;
+                auto& waiter = static_cast<EventWaiter&>(*link);
+                if (waiter.matches_(waiter, event)) {
+                    unlink_waiter(*link);
+                    link_waiter(firing, *link);
+                    waiter.state_ = EventWaiter::State::Firing;
+                    waiting_.fetch_sub(1, std::memory_order_relaxed);
+                }
+                link = next;
+            }
+        }
+
+        // One at a time, so a resumed flow may still cancel another one that matched
+        while (true) {
+            EventWaiter* waiter;
+            {
+                std::lock_guard<std::mutex> lock(waiters_mutex_);
+                if (firing.next == &firing) break;
+                waiter = &static_cast<EventWaiter&>(*firing.next);
+                unlink_waiter(*firing.next);
+                waiter->state_ = EventWaiter::State::Fired;
+                waiter->event_ = &event;
+            }
+            waiter->handle_.resume();
+        }
+    } catch (...) {
+        restore();
+        throw;
+    }
+}
+
+size_t EventDispatcher::waiting_coroutines() const {
+    return waiting_.load(std::memory_order_relaxed);
+}
+
+HandlerId EventDispatcher::add_observer(DispatchObserver observer, std::function<void()> on_destroyed) {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    HandlerId id = next_id_++;
+    auto table = std::make_unique<ObserverTable>(observers_.writer_view());
+    table->observers.push_back(ObserverEntry{id, std::move(observer), std::move(on_destroyed)});
+    observers_.publish(std::move(table));
+    observing_.store(true, std::memory_order_release);
+    return id;
+}
+
+void EventDispatcher::remove_observer(HandlerId id) {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    auto table = std::make_unique<ObserverTable>(observers_.writer_view());
+    auto it = std::find_if(table->observers.begin(), table->observers.end(),
+        [id](const ObserverEntry& entry) { return entry.id == id; });
+    if (it == table->observers.end()) return;
+    table->observers.erase(it);
+    observing_.store(!table->observers.empty(), std::memory_order_release);
+    observers_.publish(std::move(table));
+}
+
+void EventDispatcher::notify_observers(const Event& event) {
+    auto table = observers_.read();
+    for (const ObserverEntry& entry : table->observers) {
+        entry.observer(event);
+    }
+}
+
+void EventDispatcher::enable_metrics(const MetricsConfig& config) {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    if (metrics_storage_) {
+        metrics_storage_->configure(config);
+    } else {
+        metrics_storage_ = std::make_unique<DispatcherMetrics>(config);
+    }
+    metrics_.store(metrics_storage_.get(), std::memory_order_release);
+}
+
+void EventDispatcher::disable_metrics() {
+    // The collector stays alive: dispatches in flight may still be recording into it
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    metrics_.store(nullptr, std::memory_order_release);
+}
+
+bool EventDispatcher::metrics_enabled() const {
+    return metrics_.load(std::memory_order_acquire) != nullptr;
+}
+
+MetricsSnapshot EventDispatcher::metrics_snapshot() const {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    if (!metrics_storage_) {
+        return MetricsSnapshot{{}, {}, 0};
+    }
+    return metrics_storage_->snapshot();
+}
+
+void EventDispatcher::reset_metrics() {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    if (metrics_storage_) {
+        metrics_storage_->reset();
+    }
 }
 
 size_t EventDispatcher::handler_count(const std::string& event_type) const {
-    auto it = handlers_.find(event_type);
-    if (it != handlers_.end()) {
-        return it->second.size();
+    if (auto type_id = event_type_registry().find(event_type)) {
+        return handler_count(*type_id);
+    }
+    return 0;
+}
+
+size_t EventDispatcher::handler_count(EventTypeId type_id) const {
+    auto table = handlers_.read();
+    if (type_id >= table->resolved_types && !table->wildcards.empty()) {
+        // Interned after the last resolution: only wildcards can match
+        const std::string& type = event_type_registry().name(type_id);
+        return static_cast<size_t>(std::count_if(table->wildcards.begin(), table->wildcards.end(),
+            [&type](const WildcardEntry& wildcard) {
+                return !wildcard.entry.removed() && matches_prefix(type, wildcard.prefix);
+            }));
+    }
+    if (type_id < table->lists.size() && table->lists[type_id]) {
+        const HandlerList& handler_list = *table->lists[type_id];
+        return static_cast<size_t>(std::count_if(handler_list.begin(), handler_list.end(),
+            [](const HandlerEntry& entry) { return !entry.removed(); }));
     }
     return 0;
 }
@@ -110,6 +1381,10 @@ bool EventDispatcher::has_handlers(const std::string& event_type) const {
     return handler_count(event_type) > 0;
 }
 
+bool EventDispatcher::has_handlers(EventTypeId type_id) const {
+    return handler_count(type_id) > 0;
+}
+
 // =============================================================================
 // EventBus
 // =============================================================================
@@ -133,14 +1408,22 @@ void EventBus::dispatch(Event& event) {
     dispatcher_.dispatch(event);
 }
 
-void EventBus::queue_event(std::unique_ptr<Event> event) {
-    dispatcher_.queue_event(std::move(event));
+bool EventBus::queue_event(std::unique_ptr<Event> event) {
+    return dispatcher_.queue_event(std::move(event));
 }
 
 void EventBus::process_queue() {
     dispatcher_.process_queue();
 }
 
+void EventBus::process_queue(std::chrono::steady_clock::duration max_duration) {
+    dispatcher_.process_queue(max_duration);
+}
+
+void EventBus::configure_queue(const QueueConfig& config) {
+    dispatcher_.configure_queue(config);
+}
+
 // =============================================================================
 // SubscriptionGuard
 // =============================================================================
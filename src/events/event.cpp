@@ -1,4 +1,7 @@
 #include "events/event.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <typeinfo>
 
 namespace temp2::events {
 
@@ -6,30 +9,95 @@ namespace temp2::events {
 // Event
 // =============================================================================
 
-Event::Event() : type_("unknown"), timestamp_(std::chrono::steady_clock::now()), handled_(false) {}
+namespace {
+
+// Built-in event types are interned once so their constructors skip the registry lookup.
+const NameRegistry::Entry& mouse_type() {
+    static const NameRegistry::Entry type = event_type_registry().intern_entry("mouse");
+    return type;
+}
+
+const NameRegistry::Entry& keyboard_type() {
+    static const NameRegistry::Entry type = event_type_registry().intern_entry("keyboard");
+    return type;
+}
+
+const NameRegistry::Entry& window_type() {
+    static const NameRegistry::Entry type = event_type_registry().intern_entry("window");
+    return type;
+}
+
+const NameRegistry::Entry& custom_type() {
+    static const NameRegistry::Entry type = event_type_registry().intern_entry("custom");
+    return type;
+}
+
+}  // namespace
+
+Event::Event() : Event("unknown") {}
 
 Event::Event(const std::string& type)
-    : type_(type), timestamp_(std::chrono::steady_clock::now()), handled_(false) {}
+    : Event(event_type_registry().intern_entry(type)) {}
+
+Event::Event(const NameRegistry::Entry& type)
+    : type_(type.name), type_id_(type.id), timestamp_(std::chrono::steady_clock::now()), handled_(false) {}
 
-const std::string& Event::type() const { return type_; }
+void* Event::operator new(std::size_t size) {
+    return EventPool::instance().allocate(size);
+}
+
+void Event::operator delete(void* ptr, std::size_t size) {
+    EventPool::instance().deallocate(ptr, size);
+}
+
+std::unique_ptr<Event> Event::clone() const {
+    // Copying a subclass through the base would slice it, and handlers that
+    // static_cast the copy back to the subclass would then read past it
+    if (typeid(*this) != typeid(Event)) {
+        throw std::logic_error("Event subclass " + std::string(typeid(*this).name()) + " does not override clone()");
+    }
+    return std::make_unique<Event>(*this);
+}
+
+const std::string& Event::type() const { return *type_; }
+EventTypeId Event::type_id() const { return type_id_; }
 Event::Timestamp Event::timestamp() const { return timestamp_; }
-bool Event::is_handled() const { return handled_; }
-void Event::set_handled(bool handled) { handled_ = handled; }
+// Atomic access so parallel-safe handlers of one fan-out tier may race on the flag
+bool Event::is_handled() const {
+    return std::atomic_ref<bool>(const_cast<bool&>(handled_)).load(std::memory_order_relaxed);
+}
+void Event::set_handled(bool handled) {
+    std::atomic_ref<bool>(handled_).store(handled, std::memory_order_relaxed);
+}
 
 void Event::set_data(const std::string& key, const std::any& value) {
-    data_[key] = value;
+    set_data(attribute_key_registry().intern(key), value);
+}
+
+void Event::set_data(AttributeKey key, const std::any& value) {
+    data_.set(key, AttributeValue::from_any(value));
 }
 
 std::any Event::get_data(const std::string& key) const {
-    auto it = data_.find(key);
-    if (it != data_.end()) {
-        return it->second;
+    auto key_id = attribute_key_registry().find(key);
+    if (!key_id) {
+        return {};
     }
-    return {};
+    const AttributeValue* value = data_.find(*key_id);
+    return value ? value->to_any() : std::any();
 }
 
 bool Event::has_data(const std::string& key) const {
-    return data_.find(key) != data_.end();
+    auto key_id = attribute_key_registry().find(key);
+    return key_id && data_.contains(*key_id);
+}
+
+bool Event::has_data(AttributeKey key) const {
+    return data_.contains(key);
+}
+
+const AttributeStore& Event::attributes() const {
+    return data_;
 }
 
 // =============================================================================
@@ -37,7 +105,15 @@ bool Event::has_data(const std::string& key) const {
 // =============================================================================
 
 MouseEvent::MouseEvent(Action action, double x, double y, Button button)
-    : Event("mouse"), action_(action), button_(button), x_(x), y_(y), scroll_delta_(0) {}
+    : Event(mouse_type()), action_(action), button_(button), x_(x), y_(y), scroll_delta_(0) {}
+
+std::unique_ptr<Event> MouseEvent::clone() const {
+    return std::make_unique<MouseEvent>(*this);
+}
+
+EventTypeId MouseEvent::static_type_id() {
+    return mouse_type().id;
+}
 
 MouseEvent::Action MouseEvent::action() const { return action_; }
 MouseEvent::Button MouseEvent::button() const { return button_; }
@@ -51,7 +127,15 @@ void MouseEvent::set_scroll_delta(double delta) { scroll_delta_ = delta; }
 // =============================================================================
 
 KeyboardEvent::KeyboardEvent(Action action, int key_code, int modifiers)
-    : Event("keyboard"), action_(action), key_code_(key_code), modifiers_(modifiers) {}
+    : Event(keyboard_type()), action_(action), key_code_(key_code), modifiers_(modifiers) {}
+
+std::unique_ptr<Event> KeyboardEvent::clone() const {
+    return std::make_unique<KeyboardEvent>(*this);
+}
+
+EventTypeId KeyboardEvent::static_type_id() {
+    return keyboard_type().id;
+}
 
 KeyboardEvent::Action KeyboardEvent::action() const { return action_; }
 int KeyboardEvent::key_code() const { return key_code_; }
@@ -65,13 +149,21 @@ bool KeyboardEvent::is_alt() const { return modifiers_ & MOD_ALT; }
 // =============================================================================
 
 WindowEvent::WindowEvent(Action action)
-    : Event("window"), action_(action), width_(0), height_(0), x_(0), y_(0) {}
+    : Event(window_type()), action_(action), width_(0), height_(0), x_(0), y_(0) {}
 
 WindowEvent::WindowEvent(Action action, int width, int height)
-    : Event("window"), action_(action), width_(width), height_(height), x_(0), y_(0) {}
+    : Event(window_type()), action_(action), width_(width), height_(height), x_(0), y_(0) {}
 
 WindowEvent::WindowEvent(Action action, int x, int y, bool)
-    : Event("window"), action_(action), width_(0), height_(0), x_(x), y_(y) {}
+    : Event(window_type()), action_(action), width_(0), height_(0), x_(x), y_(y) {}
+
+std::unique_ptr<Event> WindowEvent::clone() const {
+    return std::make_unique<WindowEvent>(*this);
+}
+
+EventTypeId WindowEvent::static_type_id() {
+    return window_type().id;
+}
 
 WindowEvent::Action WindowEvent::action() const { return action_; }
 int WindowEvent::width() const { return width_; }
@@ -84,7 +176,15 @@ int WindowEvent::y() const { return y_; }
 // =============================================================================
 
 CustomEvent::CustomEvent(const std::string& name)
-    : Event("custom"), name_(name) {}
+    : Event(custom_type()), name_(name) {}
+
+std::unique_ptr<Event> CustomEvent::clone() const {
+    return std::make_unique<CustomEvent>(*this);
+}
+
+EventTypeId CustomEvent::static_type_id() {
+    return custom_type().id;
+}
 
 const std::string& CustomEvent::name() const { return name_; }
 
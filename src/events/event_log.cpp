@@ -0,0 +1,495 @@
+#include "events/event_log.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace temp2::events {
+
+namespace {
+
+using event_log::AttributeTag;
+using event_log::RecordKind;
+
+// Little-endian encoding, independent of the host byte order
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<unsigned char>& out) : out_(out) {}
+
+    void u8(uint8_t value) { out_.push_back(value); }
+    void u16(uint16_t value) { put(value, 2); }
+    void u32(uint32_t value) { put(value, 4); }
+    void u64(uint64_t value) { put(value, 8); }
+    void i32(int32_t value) { u32(static_cast<uint32_t>(value)); }
+    void i64(int64_t value) { u64(static_cast<uint64_t>(value)); }
+    void f64(double value) { u64(std::bit_cast<uint64_t>(value)); }
+
+    void str16(const std::string& value) {
+        if (value.size() > std::numeric_limits<uint16_t>::max()) {
+            throw std::length_error("Event log string too long");
+        }
+        u16(static_cast<uint16_t>(value.size()));
+        out_.insert(out_.end(), value.begin(), value.end());
+    }
+
+    void str32(const std::string& value) {
+        if (value.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Event log string too long");
+        }
+        u32(static_cast<uint32_t>(value.size()));
+        out_.insert(out_.end(), value.begin(), value.end());
+    }
+
+    void patch_u32(size_t at, uint32_t value) {
+        for (size_t i = 0; i < 4; ++i) {
+            out_[at + i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    void patch_u16(size_t at, uint16_t value) {
+        out_[at] = static_cast<unsigned char>(value);
+        out_[at + 1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    size_t size() const { return out_.size(); }
+
+private:
+    void put(uint64_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; ++i) {
+            out_.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    std::vector<unsigned char>& out_;
+};
+
+class ByteReader {
+public:
+    ByteReader(const unsigned char* data, size_t size) : data_(data), end_(data + size) {}
+
+    uint8_t u8() { return static_cast<uint8_t>(get(1)); }
+    uint16_t u16() { return static_cast<uint16_t>(get(2)); }
+    uint32_t u32() { return static_cast<uint32_t>(get(4)); }
+    uint64_t u64() { return get(8); }
+    int32_t i32() { return static_cast<int32_t>(u32()); }
+    int64_t i64() { return static_cast<int64_t>(u64()); }
+    double f64() { return std::bit_cast<double>(u64()); }
+
+    std::string str16() { return bytes(u16()); }
+    std::string str32() { return bytes(u32()); }
+
+private:
+    void need(size_t count) const {
+        if (static_cast<size_t>(end_ - data_) < count) {
+            throw std::runtime_error("Corrupt event log record");
+        }
+    }
+
+    uint64_t get(size_t count) {
+        need(count);
+        uint64_t value = 0;
+        for (size_t i = 0; i < count; ++i) {
+            value |= static_cast<uint64_t>(data_[i]) << (8 * i);
+        }
+        data_ += count;
+        return value;
+    }
+
+    std::string bytes(size_t count) {
+        need(count);
+        std::string value(reinterpret_cast<const char*>(data_), count);
+        data_ += count;
+        return value;
+    }
+
+    const unsigned char* data_;
+    const unsigned char* end_;
+};
+
+size_t encode_attributes(ByteWriter& writer, const AttributeStore& attributes) {
+    size_t count_at = writer.size();
+    writer.u16(0);
+
+    uint16_t written = 0;
+    size_t skipped = 0;
+    attributes.for_each([&](AttributeKey key, const AttributeValue& value) {
+        const auto& storage = value.storage();
+        if (std::holds_alternative<std::monostate>(storage) || std::holds_alternative<std::any>(storage) ||
+            written == std::numeric_limits<uint16_t>::max()) {
+            ++skipped;
+            return;
+        }
+
+        writer.str16(attribute_key_registry().name(key));
+        if (const bool* b = std::get_if<bool>(&storage)) {
+            writer.u8(static_cast<uint8_t>(AttributeTag::Bool));
+            writer.u8(*b ? 1 : 0);
+        } else if (const int* i = std::get_if<int>(&storage)) {
+            writer.u8(static_cast<uint8_t>(AttributeTag::Int));
+            writer.i32(*i);
+        } else if (const int64_t* l = std::get_if<int64_t>(&storage)) {
+            writer.u8(static_cast<uint8_t>(AttributeTag::Int64));
+            writer.i64(*l);
+        } else if (const double* d = std::get_if<double>(&storage)) {
+            writer.u8(static_cast<uint8_t>(AttributeTag::Double));
+            writer.f64(*d);
+        } else {
+            writer.u8(static_cast<uint8_t>(AttributeTag::String));
+            writer.str32(std::get<std::string>(storage));
+        }
+        ++written;
+    });
+
+    writer.patch_u16(count_at, written);
+    return skipped;
+}
+
+void decode_attributes(ByteReader& reader, Event& event) {
+    uint16_t count = reader.u16();
+    for (uint16_t i = 0; i < count; ++i) {
+        AttributeKey key = attribute_key_registry().intern(reader.str16());
+        switch (static_cast<AttributeTag>(reader.u8())) {
+            case AttributeTag::Bool: event.set_data(key, reader.u8() != 0); break;
+            case AttributeTag::Int: event.set_data(key, static_cast<int>(reader.i32())); break;
+            case AttributeTag::Int64: event.set_data(key, reader.i64()); break;
+            case AttributeTag::Double: event.set_data(key, reader.f64()); break;
+            case AttributeTag::String: event.set_data(key, reader.str32()); break;
+            default: throw std::runtime_error("Unknown attribute tag in event log");
+        }
+    }
+}
+
+std::unique_ptr<Event> decode_event(ByteReader& reader, RecordKind kind, const std::string& type) {
+    switch (kind) {
+        case RecordKind::Mouse: {
+            auto action = static_cast<MouseEvent::Action>(reader.u8());
+            auto button = static_cast<MouseEvent::Button>(reader.u8());
+            double x = reader.f64();
+            double y = reader.f64();
+            auto event = std::make_unique<MouseEvent>(action, x, y, button);
+            event->set_scroll_delta(reader.f64());
+            return event;
+        }
+        case RecordKind::Keyboard: {
+            auto action = static_cast<KeyboardEvent::Action>(reader.u8());
+            int key_code = reader.i32();
+            int modifiers = reader.i32();
+            return std::make_unique<KeyboardEvent>(action, key_code, modifiers);
+        }
+        case RecordKind::Window: {
+            auto action = static_cast<WindowEvent::Action>(reader.u8());
+            int width = reader.i32();
+            int height = reader.i32();
+            int x = reader.i32();
+            int y = reader.i32();
+            // WindowEvent carries either a size or a position
+            if (width != 0 || height != 0) {
+                return std::make_unique<WindowEvent>(action, width, height);
+            }
+            if (x != 0 || y != 0) {
+                return std::make_unique<WindowEvent>(action, x, y, true);
+            }
+            return std::make_unique<WindowEvent>(action);
+        }
+        case RecordKind::Custom:
+            return std::make_unique<CustomEvent>(reader.str16());
+        case RecordKind::Generic:
+            return std::make_unique<Event>(type);
+    }
+    throw std::runtime_error("Unknown record kind in event log");
+}
+
+}  // namespace
+
+// =============================================================================
+// EventRecorder
+// =============================================================================
+
+EventRecorder::EventRecorder(const std::string& path)
+    : out_(path, std::ios::binary | std::ios::trunc)
+    , start_(std::chrono::steady_clock::now())
+    , recorded_(0)
+    , skipped_attributes_(0)
+    , skipped_events_(0)
+    , dispatcher_(nullptr)
+    , observer_id_(0) {
+    if (!out_) {
+        throw std::runtime_error("Cannot open event log for writing: " + path);
+    }
+
+    buffer_.reserve(FLUSH_THRESHOLD + 1024);
+    buffer_.insert(buffer_.end(), std::begin(event_log::MAGIC), std::end(event_log::MAGIC));
+    ByteWriter writer(buffer_);
+    writer.u32(event_log::FORMAT_VERSION);
+    writer.u32(0);
+}
+
+EventRecorder::~EventRecorder() {
+    detach();
+    try {
+        flush();
+    } catch (...) {
+        // Destructors must not throw; the last block is lost
+    }
+}
+
+void EventRecorder::attach(EventDispatcher& dispatcher) {
+    detach();
+    dispatcher_ = &dispatcher;
+    observer_id_ = dispatcher.add_observer([this](const Event& event) { observe(event); },
+                                           [this] {
+                                               dispatcher_ = nullptr;
+                                               observer_id_ = 0;
+                                           });
+}
+
+void EventRecorder::detach() {
+    if (dispatcher_) {
+        dispatcher_->remove_observer(observer_id_);
+        dispatcher_ = nullptr;
+        observer_id_ = 0;
+    }
+}
+
+void EventRecorder::record(const Event& event) {
+    RecordKind kind = RecordKind::Generic;
+    if (dynamic_cast<const MouseEvent*>(&event)) {
+        kind = RecordKind::Mouse;
+    } else if (dynamic_cast<const KeyboardEvent*>(&event)) {
+        kind = RecordKind::Keyboard;
+    } else if (dynamic_cast<const WindowEvent*>(&event)) {
+        kind = RecordKind::Window;
+    } else if (dynamic_cast<const CustomEvent*>(&event)) {
+        kind = RecordKind::Custom;
+    }
+
+    auto offset = event.timestamp() - start_;
+    uint64_t offset_ns = offset.count() > 0
+        ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(offset).count())
+        : 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Encoded aside so a string that does not fit leaves no partial record
+    scratch_.clear();
+    ByteWriter writer(scratch_);
+    writer.u32(0);
+
+    writer.u8(static_cast<uint8_t>(kind));
+    writer.u64(offset_ns);
+    writer.str16(event.type());
+
+    switch (kind) {
+        case RecordKind::Mouse: {
+            const auto& mouse = static_cast<const MouseEvent&>(event);
+            writer.u8(static_cast<uint8_t>(mouse.action()));
+            writer.u8(static_cast<uint8_t>(mouse.button()));
+            writer.f64(mouse.x());
+            writer.f64(mouse.y());
+            writer.f64(mouse.scroll_delta());
+            break;
+        }
+        case RecordKind::Keyboard: {
+            const auto& keyboard = static_cast<const KeyboardEvent&>(event);
+            writer.u8(static_cast<uint8_t>(keyboard.action()));
+            writer.i32(keyboard.key_code());
+            writer.i32(keyboard.modifiers());
+            break;
+        }
+        case RecordKind::Window: {
+            const auto& window = static_cast<const WindowEvent&>(event);
+            writer.u8(static_cast<uint8_t>(window.action()));
+            writer.i32(window.width());
+            writer.i32(window.height());
+            writer.i32(window.x());
+            writer.i32(window.y());
+            break;
+        }
+        case RecordKind::Custom:
+            writer.str16(static_cast<const CustomEvent&>(event).name());
+            break;
+        case RecordKind::Generic:
+            break;
+    }
+
+    size_t skipped = encode_attributes(writer, event.attributes());
+    writer.patch_u32(0, static_cast<uint32_t>(writer.size() - 4));
+
+    buffer_.insert(buffer_.end(), scratch_.begin(), scratch_.end());
+    skipped_attributes_ += skipped;
+    ++recorded_;
+
+    if (buffer_.size() >= FLUSH_THRESHOLD) {
+        write_buffer();
+    }
+}
+
+void EventRecorder::observe(const Event& event) {
+    try {
+        record(event);
+    } catch (const std::length_error&) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++skipped_events_;
+    }
+}
+
+void EventRecorder::write_buffer() {
+    out_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+    if (!out_) {
+        throw std::runtime_error("Failed to write event log");
+    }
+}
+
+void EventRecorder::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    write_buffer();
+    out_.flush();
+}
+
+size_t EventRecorder::recorded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recorded_;
+}
+
+size_t EventRecorder::skipped_attributes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return skipped_attributes_;
+}
+
+size_t EventRecorder::skipped_events() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return skipped_events_;
+}
+
+// =============================================================================
+// EventLogReader
+// =============================================================================
+
+EventLogReader::EventLogReader(const std::string& path)
+    : data_(nullptr), size_(0), position_(event_log::HEADER_SIZE) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open event log: " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < event_log::HEADER_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("Not an event log: " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map event log: " + path);
+    }
+    data_ = static_cast<const unsigned char*>(mapping);
+    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+
+    ByteReader header(data_ + sizeof(event_log::MAGIC), event_log::HEADER_SIZE - sizeof(event_log::MAGIC));
+    if (std::memcmp(data_, event_log::MAGIC, sizeof(event_log::MAGIC)) != 0 ||
+        header.u32() != event_log::FORMAT_VERSION) {
+        ::munmap(mapping, size_);
+        throw std::runtime_error("Not an event log: " + path);
+    }
+}
+
+EventLogReader::~EventLogReader() {
+    ::munmap(const_cast<unsigned char*>(data_), size_);
+}
+
+bool EventLogReader::next(Record& record) {
+    if (size_ - position_ < 4) return false;
+    ByteReader prefix(data_ + position_, 4);
+    uint32_t length = prefix.u32();
+    if (size_ - position_ - 4 < length) return false;  // Torn final record
+
+    ByteReader reader(data_ + position_ + 4, length);
+    auto kind = static_cast<RecordKind>(reader.u8());
+    uint64_t offset_ns = reader.u64();
+    std::string type = reader.str16();
+
+    record.event = decode_event(reader, kind, type);
+    decode_attributes(reader, *record.event);
+    record.offset = std::chrono::nanoseconds(static_cast<int64_t>(offset_ns));
+
+    position_ += 4 + static_cast<size_t>(length);
+    return true;
+}
+
+void EventLogReader::rewind() {
+    position_ = event_log::HEADER_SIZE;
+}
+
+size_t EventLogReader::size_bytes() const {
+    return size_;
+}
+
+size_t EventLogReader::position() const {
+    return position_;
+}
+
+// =============================================================================
+// EventReplayer
+// =============================================================================
+
+EventReplayer::EventReplayer(const std::string& path) : reader_(path) {}
+
+ReplayStats EventReplayer::replay(EventDispatcher& dispatcher, const ReplayOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    if (options.mode == ReplayMode::RealTime && options.speed <= 0.0) {
+        throw std::invalid_argument("Replay speed must be positive");
+    }
+
+    reader_.rewind();
+    const size_t batch_size = std::max<size_t>(dispatcher.queue_config().batch_size, 1);
+    const auto start = Clock::now();
+    size_t events = 0;
+    EventLogReader::Record record;
+
+    while (reader_.next(record)) {
+        if (options.mode == ReplayMode::RealTime) {
+            auto due = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::nano>(static_cast<double>(record.offset.count()) / options.speed));
+            if (due > Clock::now()) {
+                if (options.queued) {
+                    dispatcher.process_queue();  // Deliver what is due before sleeping
+                }
+                std::this_thread::sleep_until(due);
+            }
+        }
+
+        if (options.queued) {
+            dispatcher.queue_event(std::move(record.event));
+            if (++events % batch_size == 0) {
+                dispatcher.process_queue();
+            }
+        } else {
+            dispatcher.dispatch(*record.event);
+            ++events;
+        }
+    }
+    if (options.queued) {
+        dispatcher.process_queue();
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    size_t bytes = reader_.position() - event_log::HEADER_SIZE;
+    ReplayStats stats;
+    stats.events = events;
+    stats.bytes = bytes;
+    stats.seconds = seconds;
+    stats.events_per_second = seconds > 0.0 ? static_cast<double>(events) / seconds : 0.0;
+    stats.megabytes_per_second = seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+    return stats;
+}
+
+}  // namespace temp2::events
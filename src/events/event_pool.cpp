@@ -0,0 +1,161 @@
+#include "events/event_pool.hpp"
+#include <new>
+
+namespace temp2::events {
+
+// =============================================================================
+// EventPool
+// =============================================================================
+
+struct EventPool::ThreadCache {
+    std::array<FreeList, CLASS_COUNT> lists;
+};
+
+void EventPool::FreeList::push(FreeBlock* block) {
+    block->next = head;
+    head = block;
+    ++count;
+}
+
+EventPool::FreeBlock* EventPool::FreeList::pop() {
+    FreeBlock* block = head;
+    if (block) {
+        head = block->next;
+        --count;
+    }
+    return block;
+}
+
+EventPool::EventPool()
+    : chunk_allocations_(0), reserved_bytes_(0), oversize_allocations_(0) {}
+
+EventPool& EventPool::instance() {
+    // Intentionally never destroyed; see class comment
+    static EventPool* pool = new EventPool();
+    return *pool;
+}
+
+EventPool::ThreadCache* EventPool::thread_cache() {
+    static thread_local ThreadCache* current = nullptr;
+    static thread_local bool exited = false;
+
+    struct Owner {
+        ThreadCache cache;
+
+        Owner() { current = &cache; }
+        ~Owner() {
+            current = nullptr;
+            exited = true;
+            for (size_t i = 0; i < CLASS_COUNT; ++i) {
+                instance().release(cache.lists[i], i, cache.lists[i].count);
+            }
+        }
+    };
+
+    if (!current && !exited) {
+        static thread_local Owner owner;
+    }
+    return current;
+}
+
+size_t EventPool::size_class(size_t size) {
+    return size == 0 ? 0 : (size - 1) / BLOCK_SIZE;
+}
+
+void* EventPool::allocate(size_t size) {
+    if (size > MAX_BLOCK_SIZE) {
+        oversize_allocations_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    size_t cls = size_class(size);
+    ThreadCache* cache = thread_cache();
+    if (!cache) {
+        // Thread is shutting down; serve straight from the depot
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!depot_[cls].head) {
+            allocate_chunk(cls);
+        }
+        return depot_[cls].pop();
+    }
+
+    FreeList& list = cache->lists[cls];
+    if (!list.head) {
+        refill(list, cls);
+    }
+    return list.pop();
+}
+
+void EventPool::deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+
+    if (size > MAX_BLOCK_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    size_t cls = size_class(size);
+    auto* block = static_cast<FreeBlock*>(ptr);
+    ThreadCache* cache = thread_cache();
+    if (!cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        depot_[cls].push(block);
+        return;
+    }
+
+    FreeList& list = cache->lists[cls];
+    list.push(block);
+    if (list.count > THREAD_CACHE_LIMIT) {
+        release(list, cls, THREAD_CACHE_LIMIT / 2);
+    }
+}
+
+void EventPool::refill(FreeList& list, size_t cls) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeList& depot = depot_[cls];
+    if (depot.count < TRANSFER_BATCH) {
+        allocate_chunk(cls);
+    }
+    for (size_t i = 0; i < TRANSFER_BATCH && depot.head; ++i) {
+        list.push(depot.pop());
+    }
+}
+
+void EventPool::release(FreeList& list, size_t cls, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeList& depot = depot_[cls];
+    for (size_t i = 0; i < count && list.head; ++i) {
+        depot.push(list.pop());
+    }
+}
+
+void EventPool::allocate_chunk(size_t cls) {
+    const size_t block_size = (cls + 1) * BLOCK_SIZE;
+    const size_t bytes = block_size * BLOCKS_PER_CHUNK;
+    auto* chunk = static_cast<char*>(::operator new(bytes, std::align_val_t(BLOCK_SIZE)));
+
+    for (size_t i = BLOCKS_PER_CHUNK; i > 0; --i) {
+        depot_[cls].push(reinterpret_cast<FreeBlock*>(chunk + (i - 1) * block_size));
+    }
+
+    ++chunk_allocations_;
+    reserved_bytes_ += bytes;
+}
+
+void EventPool::reserve(size_t size, size_t count) {
+    if (size > MAX_BLOCK_SIZE) return;
+
+    size_t cls = size_class(size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (depot_[cls].count < count) {
+        allocate_chunk(cls);
+    }
+}
+
+EventPool::Stats EventPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Stats{chunk_allocations_, reserved_bytes_,
+                 oversize_allocations_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace temp2::events
@@ -0,0 +1,303 @@
+#include "events/event_queue.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+namespace temp2::events {
+
+// =============================================================================
+// EventRingBuffer
+// =============================================================================
+
+namespace {
+
+size_t round_up_to_power_of_two(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Nesting depth of EventQueue::ConsumerScope on this thread
+thread_local size_t consumer_depth = 0;
+
+}  // namespace
+
+EventRingBuffer::EventRingBuffer(size_t capacity)
+    : mask_(round_up_to_power_of_two(capacity) - 1)
+    , enqueue_pos_(0)
+    , dequeue_pos_(0) {
+    cells_ = std::make_unique<Cell[]>(mask_ + 1);
+    for (size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+        cells_[i].event = nullptr;
+    }
+}
+
+EventRingBuffer::~EventRingBuffer() {
+    while (Event* event = try_pop()) {
+        delete event;
+    }
+}
+
+bool EventRingBuffer::try_push(Event* event) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+Event* EventRingBuffer::try_pop() {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return nullptr;  // Empty
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    Event* event = cell->event;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return event;
+}
+
+size_t EventRingBuffer::size() const {
+    size_t head = dequeue_pos_.load(std::memory_order_acquire);
+    size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+size_t EventRingBuffer::capacity() const {
+    return mask_ + 1;
+}
+
+// =============================================================================
+// EventQueue
+// =============================================================================
+
+EventQueue::ConsumerScope::ConsumerScope() {
+    ++consumer_depth;
+}
+
+EventQueue::ConsumerScope::~ConsumerScope() {
+    --consumer_depth;
+}
+
+EventQueue::EventQueue(const QueueConfig& config) : config_(config), dropped_(0) {
+    if (config_.mode == QueueMode::LockFree) {
+        if (config_.capacity == 0) {
+            config_.capacity = QueueConfig::DEFAULT_CAPACITY;
+        }
+        ring_ = std::make_unique<EventRingBuffer>(config_.capacity);
+        config_.capacity = ring_->capacity();
+    }
+    if (config_.batch_size == 0) {
+        config_.batch_size = 1;
+    }
+}
+
+EventQueue::~EventQueue() = default;
+
+bool EventQueue::push(std::unique_ptr<Event> event) {
+    bool pushed = ring_ ? push_lock_free(event) : push_locked(event);
+    if (pushed) {
+        return true;
+    }
+
+    // Block only gives up on a consumer thread, where waiting would deadlock
+    if (config_.policy == BackpressurePolicy::Fail || config_.policy == BackpressurePolicy::Block) {
+        throw std::overflow_error("Event queue full");
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool EventQueue::try_push(std::unique_ptr<Event>& event) {
+    if (ring_) {
+        if (ring_->try_push(event.get())) {
+            event.release();
+            return true;
+        }
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (config_.capacity != 0 && deque_.size() >= config_.capacity) {
+        return false;
+    }
+    deque_.push_back(std::move(event));
+    return true;
+}
+
+bool EventQueue::push_locked(std::unique_ptr<Event>& event) {
+    std::unique_ptr<Event> evicted;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (config_.capacity != 0 && deque_.size() >= config_.capacity) {
+        switch (config_.policy) {
+            case BackpressurePolicy::Block:
+                if (consumer_depth > 0) return false;
+                space_available_.wait(lock, [this] { return deque_.size() < config_.capacity; });
+                break;
+            case BackpressurePolicy::DropOldest:
+                evicted = std::move(deque_.front());
+                deque_.pop_front();
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case BackpressurePolicy::DropNewest:
+            case BackpressurePolicy::Fail:
+                return false;
+        }
+    }
+
+    deque_.push_back(std::move(event));
+    return true;
+}
+
+bool EventQueue::push_lock_free(std::unique_ptr<Event>& event) {
+    for (;;) {
+        if (ring_->try_push(event.get())) {
+            event.release();
+            return true;
+        }
+
+        switch (config_.policy) {
+            case BackpressurePolicy::Block:
+                if (consumer_depth > 0) return false;
+                std::this_thread::yield();
+                break;
+            case BackpressurePolicy::DropOldest:
+                if (Event* oldest = ring_->try_pop()) {
+                    delete oldest;
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            case BackpressurePolicy::DropNewest:
+            case BackpressurePolicy::Fail:
+                return false;
+        }
+    }
+}
+
+std::unique_ptr<Event> EventQueue::pop() {
+    if (ring_) {
+        return std::unique_ptr<Event>(ring_->try_pop());
+    }
+
+    std::unique_ptr<Event> event;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (deque_.empty()) {
+            return nullptr;
+        }
+        event = std::move(deque_.front());
+        deque_.pop_front();
+    }
+    notify_space();
+    return event;
+}
+
+size_t EventQueue::pop_batch(std::vector<std::unique_ptr<Event>>& out, size_t max_count) {
+    size_t count = 0;
+
+    if (ring_) {
+        while (count < max_count) {
+            Event* event = ring_->try_pop();
+            if (!event) break;
+            out.emplace_back(event);
+            ++count;
+        }
+        return count;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (count < max_count && !deque_.empty()) {
+            out.push_back(std::move(deque_.front()));
+            deque_.pop_front();
+            ++count;
+        }
+    }
+    if (count > 0) {
+        notify_space();
+    }
+    return count;
+}
+
+void EventQueue::clear() {
+    if (ring_) {
+        while (Event* event = ring_->try_pop()) {
+            delete event;
+        }
+        return;
+    }
+
+    std::deque<std::unique_ptr<Event>> discarded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(discarded, deque_);
+    }
+    notify_space();
+}
+
+void EventQueue::notify_space() {
+    if (config_.capacity != 0 && config_.policy == BackpressurePolicy::Block) {
+        space_available_.notify_all();
+    }
+}
+
+size_t EventQueue::size() const {
+    if (ring_) {
+        return ring_->size();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return deque_.size();
+}
+
+bool EventQueue::empty() const {
+    return size() == 0;
+}
+
+size_t EventQueue::capacity() const {
+    return config_.capacity;
+}
+
+size_t EventQueue::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+const QueueConfig& EventQueue::config() const {
+    return config_;
+}
+
+}  // namespace temp2::events
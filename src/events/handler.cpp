@@ -1,4 +1,5 @@
 #include "events/handler.hpp"
+#include <mutex>
 
 namespace temp2::events {
 
@@ -52,6 +53,176 @@ void ThrottledHandler::reset() {
     last_call_ = Clock::time_point::min();
 }
 
+// =============================================================================
+// TrailingDebouncedHandler
+// =============================================================================
+
+struct TrailingDebouncedHandler::State {
+    State(EventDispatcher& owner, HandlerFunc func, Duration wait)
+        : dispatcher(owner), handler(std::move(func)), delay(wait) {}
+
+    EventDispatcher& dispatcher;
+    HandlerFunc handler;
+    Duration delay;
+
+    std::mutex mutex;
+    std::unique_ptr<Event> pending;
+    uint64_t sequence = 0;  // Bumped per event; stale timers see a mismatch and do nothing
+    TimerId timer = 0;
+};
+
+TrailingDebouncedHandler::TrailingDebouncedHandler(EventDispatcher& dispatcher, HandlerFunc handler,
+                                                   Duration delay)
+    : state_(std::make_shared<State>(dispatcher, std::move(handler), delay)) {}
+
+void TrailingDebouncedHandler::operator()(Event& event) {
+    auto copy = event.clone();
+    copy->set_handled(false);
+
+    uint64_t sequence;
+    TimerId previous;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->pending = std::move(copy);
+        sequence = ++state_->sequence;
+        previous = std::exchange(state_->timer, 0);
+    }
+    if (previous != 0) {
+        state_->dispatcher.cancel_timer(previous);
+    }
+
+    std::weak_ptr<State> weak = state_;
+    TimerId timer = state_->dispatcher.schedule_callback([weak, sequence] {
+        auto state = weak.lock();
+        if (!state) return;
+
+        std::unique_ptr<Event> event;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->sequence != sequence || !state->pending) return;
+            event = std::move(state->pending);
+            state->timer = 0;
+        }
+        if (state->handler) {
+            state->handler(*event);
+        }
+    }, state_->delay);
+
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (state_->sequence == sequence) {
+        state_->timer = timer;
+    }
+}
+
+void TrailingDebouncedHandler::reset() {
+    TimerId timer;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->pending.reset();
+        ++state_->sequence;
+        timer = std::exchange(state_->timer, 0);
+    }
+    if (timer != 0) {
+        state_->dispatcher.cancel_timer(timer);
+    }
+}
+
+// =============================================================================
+// TrailingThrottledHandler
+// =============================================================================
+
+struct TrailingThrottledHandler::State : std::enable_shared_from_this<State> {
+    State(EventDispatcher& owner, HandlerFunc func, Duration period)
+        : dispatcher(owner), handler(std::move(func)), interval(period) {}
+
+    void open_window();
+    void close_window(uint64_t window);
+
+    EventDispatcher& dispatcher;
+    HandlerFunc handler;
+    Duration interval;
+
+    std::mutex mutex;
+    std::unique_ptr<Event> pending;
+    bool window_open = false;
+    uint64_t window = 0;  // Bumped by reset so timers of an abandoned window do nothing
+    TimerId timer = 0;
+};
+
+void TrailingThrottledHandler::State::open_window() {
+    uint64_t current;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = window;
+    }
+
+    std::weak_ptr<State> weak = weak_from_this();
+    TimerId id = dispatcher.schedule_callback([weak, current] {
+        if (auto state = weak.lock()) {
+            state->close_window(current);
+        }
+    }, interval);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (window == current) {
+        timer = id;
+    }
+}
+
+void TrailingThrottledHandler::State::close_window(uint64_t closing) {
+    std::unique_ptr<Event> event;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (window != closing) return;
+        timer = 0;
+        event = std::move(pending);
+        window_open = event != nullptr;
+    }
+
+    if (event) {
+        // Trailing delivery starts the next window
+        open_window();
+        if (handler) {
+            handler(*event);
+        }
+    }
+}
+
+TrailingThrottledHandler::TrailingThrottledHandler(EventDispatcher& dispatcher, HandlerFunc handler,
+                                                   Duration interval)
+    : state_(std::make_shared<State>(dispatcher, std::move(handler), interval)) {}
+
+void TrailingThrottledHandler::operator()(Event& event) {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->window_open) {
+            state_->pending = event.clone();
+            state_->pending->set_handled(false);
+            return;
+        }
+        state_->window_open = true;
+    }
+
+    state_->open_window();
+    if (state_->handler) {
+        state_->handler(event);
+    }
+}
+
+void TrailingThrottledHandler::reset() {
+    TimerId timer;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->pending.reset();
+        state_->window_open = false;
+        ++state_->window;
+        timer = std::exchange(state_->timer, 0);
+    }
+    if (timer != 0) {
+        state_->dispatcher.cancel_timer(timer);
+    }
+}
+
 // =============================================================================
 // OnceHandler
 // =============================================================================
@@ -0,0 +1,313 @@
+#include "events/metrics.hpp"
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
+
+namespace temp2::events {
+
+namespace {
+
+std::atomic<uint64_t> next_instance_id{1};
+
+// Bumped by every destroyed instance so threads know when to prune their shard caches
+std::atomic<uint64_t> destroyed_generation{0};
+
+struct LiveInstances {
+    std::mutex mutex;
+    std::unordered_set<uint64_t> ids;
+};
+
+LiveInstances& live_instances() {
+    static LiveInstances live;
+    return live;
+}
+
+size_t bucket_for(uint64_t ns) {
+    if (ns < 2) return 0;
+    return std::min<size_t>(static_cast<size_t>(std::bit_width(ns)) - 1, LatencyStats::BUCKETS - 1);
+}
+
+// Shards have a single writer, so a relaxed load/store pair is enough and
+// avoids a locked read-modify-write on the hot path
+void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+// =============================================================================
+// LatencyStats
+// =============================================================================
+
+double LatencyStats::mean_ns() const {
+    return samples == 0 ? 0.0 : static_cast<double>(total_ns) / static_cast<double>(samples);
+}
+
+uint64_t LatencyStats::percentile_ns(double percentile) const {
+    if (samples == 0) return 0;
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    auto target = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(samples));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += histogram[i];
+        if (seen >= target) {
+            // Upper edge of the bucket, never beyond the observed maximum
+            uint64_t upper = i + 1 < 64 ? (uint64_t{1} << (i + 1)) - 1 : max_ns;
+            return std::min(upper, max_ns);
+        }
+    }
+    return max_ns;
+}
+
+// =============================================================================
+// DispatcherMetrics
+// =============================================================================
+
+struct DispatcherMetrics::LatencyCounter {
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    std::array<std::atomic<uint64_t>, LatencyStats::BUCKETS> histogram{};
+
+    void record(uint64_t ns) {
+        bump(samples, 1);
+        bump(total_ns, ns);
+        if (ns > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(ns, std::memory_order_relaxed);
+        }
+        bump(histogram[bucket_for(ns)], 1);
+    }
+
+    void merge_into(LatencyStats& stats) const {
+        stats.samples += samples.load(std::memory_order_relaxed);
+        stats.total_ns += total_ns.load(std::memory_order_relaxed);
+        stats.max_ns = std::max(stats.max_ns, max_ns.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < LatencyStats::BUCKETS; ++i) {
+            stats.histogram[i] += histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void reset() {
+        samples.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+        for (auto& bucket : histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct DispatcherMetrics::TypeCounters {
+    std::atomic<uint64_t> dispatches{0};
+    LatencyCounter dispatch_latency;
+    LatencyCounter queue_wait;
+};
+
+struct DispatcherMetrics::HandlerCounters {
+    explicit HandlerCounters(EventTypeId type) : type_id(type) {}
+
+    const EventTypeId type_id;
+    std::atomic<uint64_t> invocations{0};
+    LatencyCounter latency;
+};
+
+/**
+ * @brief Per-thread counters
+ *
+ * Only the owning thread writes the counters or inserts into the maps.
+ * Inserts take the mutex so snapshot() can walk the maps safely; the owner's
+ * own lookups need no lock because nobody else modifies the maps.
+ */
+struct DispatcherMetrics::Shard {
+    std::mutex mutex;
+    std::unordered_map<EventTypeId, std::unique_ptr<TypeCounters>> types;
+    std::unordered_map<size_t, std::unique_ptr<HandlerCounters>> handlers;
+    uint32_t sample_countdown = 0;
+
+    TypeCounters& type(EventTypeId type_id) {
+        auto it = types.find(type_id);
+        if (it != types.end()) return *it->second;
+        std::lock_guard<std::mutex> lock(mutex);
+        return *types.emplace(type_id, std::make_unique<TypeCounters>()).first->second;
+    }
+
+    HandlerCounters& handler(size_t handler_id, EventTypeId type_id) {
+        auto it = handlers.find(handler_id);
+        if (it != handlers.end()) return *it->second;
+        std::lock_guard<std::mutex> lock(mutex);
+        return *handlers.emplace(handler_id, std::make_unique<HandlerCounters>(type_id)).first->second;
+    }
+};
+
+DispatcherMetrics::DispatcherMetrics(const MetricsConfig& config)
+    : instance_id_(next_instance_id.fetch_add(1, std::memory_order_relaxed))
+    , sample_every_(config.sample_every)
+    , queue_high_water_(0) {
+    LiveInstances& live = live_instances();
+    std::lock_guard<std::mutex> lock(live.mutex);
+    live.ids.insert(instance_id_);
+}
+
+DispatcherMetrics::~DispatcherMetrics() {
+    LiveInstances& live = live_instances();
+    std::lock_guard<std::mutex> lock(live.mutex);
+    live.ids.erase(instance_id_);
+    destroyed_generation.fetch_add(1, std::memory_order_release);
+}
+
+void DispatcherMetrics::configure(const MetricsConfig& config) {
+    sample_every_.store(config.sample_every, std::memory_order_relaxed);
+}
+
+DispatcherMetrics::Shard& DispatcherMetrics::local_shard() {
+    struct ShardRef {
+        uint64_t instance_id;
+        Shard* shard;
+    };
+    // Instance IDs are never reused, so entries of destroyed instances never match
+    static thread_local ShardRef last{0, nullptr};
+    static thread_local std::vector<ShardRef> known;
+    static thread_local uint64_t pruned_generation = 0;
+
+    if (last.instance_id == instance_id_) return *last.shard;
+
+    auto it = std::find_if(known.begin(), known.end(),
+        [this](const ShardRef& ref) { return ref.instance_id == instance_id_; });
+    if (it == known.end()) {
+        // Drop entries of destroyed instances before the cache grows
+        uint64_t generation = destroyed_generation.load(std::memory_order_acquire);
+        if (generation != pruned_generation) {
+            LiveInstances& live = live_instances();
+            std::lock_guard<std::mutex> lock(live.mutex);
+            std::erase_if(known, [&](const ShardRef& ref) { return !live.ids.contains(ref.instance_id); });
+            pruned_generation = generation;
+        }
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        shards_.push_back(std::make_unique<Shard>());
+        known.push_back(ShardRef{instance_id_, shards_.back().get()});
+        it = known.end() - 1;
+    }
+    last = *it;
+    return *last.shard;
+}
+
+bool DispatcherMetrics::should_sample() {
+    uint32_t every = sample_every_.load(std::memory_order_relaxed);
+    if (every == 0) return false;
+
+    Shard& shard = local_shard();
+    if (shard.sample_countdown == 0) {
+        shard.sample_countdown = every - 1;
+        return true;
+    }
+    --shard.sample_countdown;
+    return false;
+}
+
+uint64_t DispatcherMetrics::elapsed_ns(Clock::time_point start, Clock::time_point end) {
+    if (end <= start) return 0;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+void DispatcherMetrics::record_dispatch(EventTypeId type_id, uint64_t events, bool sampled,
+                                        uint64_t elapsed_ns) {
+    TypeCounters& counters = local_shard().type(type_id);
+    bump(counters.dispatches, events);
+    if (sampled) {
+        counters.dispatch_latency.record(elapsed_ns);
+    }
+}
+
+void DispatcherMetrics::record_handler(EventTypeId type_id, size_t handler_id, bool sampled,
+                                       uint64_t elapsed_ns) {
+    HandlerCounters& counters = local_shard().handler(handler_id, type_id);
+    bump(counters.invocations, 1);
+    if (sampled) {
+        counters.latency.record(elapsed_ns);
+    }
+}
+
+void DispatcherMetrics::record_queue_wait(EventTypeId type_id, uint64_t wait_ns) {
+    local_shard().type(type_id).queue_wait.record(wait_ns);
+}
+
+void DispatcherMetrics::record_queue_depth(size_t depth) {
+    size_t current = queue_high_water_.load(std::memory_order_relaxed);
+    while (depth > current &&
+           !queue_high_water_.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+    }
+}
+
+MetricsSnapshot DispatcherMetrics::snapshot() const {
+    std::map<EventTypeId, TypeMetrics> types;
+    std::map<size_t, HandlerMetrics> handlers;
+
+    {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> shard_lock(shard->mutex);
+
+            for (const auto& [type_id, counters] : shard->types) {
+                auto [it, inserted] = types.try_emplace(type_id);
+                TypeMetrics& merged = it->second;
+                if (inserted) {
+                    merged.type_id = type_id;
+                    merged.type_name = event_type_registry().name(type_id);
+                    merged.dispatches = 0;
+                }
+                merged.dispatches += counters->dispatches.load(std::memory_order_relaxed);
+                counters->dispatch_latency.merge_into(merged.dispatch_latency);
+                counters->queue_wait.merge_into(merged.queue_wait);
+            }
+
+            for (const auto& [handler_id, counters] : shard->handlers) {
+                auto [it, inserted] = handlers.try_emplace(handler_id);
+                HandlerMetrics& merged = it->second;
+                if (inserted) {
+                    merged.handler_id = handler_id;
+                    merged.type_id = counters->type_id;
+                    merged.invocations = 0;
+                }
+                merged.invocations += counters->invocations.load(std::memory_order_relaxed);
+                counters->latency.merge_into(merged.latency);
+            }
+        }
+    }
+
+    MetricsSnapshot result;
+    result.types.reserve(types.size());
+    for (auto& [type_id, merged] : types) {
+        result.types.push_back(std::move(merged));
+    }
+    result.handlers.reserve(handlers.size());
+    for (auto& [handler_id, merged] : handlers) {
+        result.handlers.push_back(std::move(merged));
+    }
+    result.queue_high_water = queue_high_water_.load(std::memory_order_relaxed);
+    return result;
+}
+
+void DispatcherMetrics::reset() {
+    // Records racing with a reset may survive it; counters stay consistent otherwise
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> shard_lock(shard->mutex);
+        for (const auto& [type_id, counters] : shard->types) {
+            counters->dispatches.store(0, std::memory_order_relaxed);
+            counters->dispatch_latency.reset();
+            counters->queue_wait.reset();
+        }
+        for (const auto& [handler_id, counters] : shard->handlers) {
+            counters->invocations.store(0, std::memory_order_relaxed);
+            counters->latency.reset();
+        }
+    }
+    queue_high_water_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace temp2::events
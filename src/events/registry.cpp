@@ -0,0 +1,61 @@
+#include "events/registry.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace temp2::events {
+
+// =============================================================================
+// NameRegistry
+// =============================================================================
+
+NameRegistry::NameRegistry() = default;
+
+NameRegistry::Id NameRegistry::intern(const std::string& name) {
+    return intern_entry(name).id;
+}
+
+NameRegistry::Entry NameRegistry::intern_entry(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return Entry{it->second, &names_[it->second]};
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto [it, inserted] = ids_.emplace(name, static_cast<Id>(names_.size()));
+    if (inserted) {
+        names_.push_back(name);
+    }
+    return Entry{it->second, &names_[it->second]};
+}
+
+std::optional<NameRegistry::Id> NameRegistry::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+const std::string& NameRegistry::name(Id id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id >= names_.size()) {
+        throw std::out_of_range("Unknown registry id");
+    }
+    return names_[id];
+}
+
+size_t NameRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+NameRegistry& event_type_registry() {
+    static NameRegistry registry;
+    return registry;
+}
+
+}  // namespace temp2::events
@@ -0,0 +1,162 @@
+#include "events/sharded_bus.hpp"
+#include <atomic>
+#include <stdexcept>
+
+namespace temp2::events {
+
+namespace {
+
+std::atomic<uint64_t> next_bus_id{1};
+
+struct ShardBinding {
+    uint64_t bus_id = 0;  // Bus IDs are never reused, so a stale binding never matches
+    ShardId shard = 0;
+};
+
+thread_local ShardBinding current_binding;
+
+}  // namespace
+
+// =============================================================================
+// ShardedEventBus
+// =============================================================================
+
+ShardedEventBus::ShardedEventBus(size_t shard_count, const QueueConfig& inbox_config)
+    : instance_id_(next_bus_id.fetch_add(1, std::memory_order_relaxed)), next_id_(1) {
+    if (shard_count == 0) {
+        throw std::invalid_argument("ShardedEventBus needs at least one shard");
+    }
+    shards_.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards_.push_back(std::make_unique<EventDispatcher>(inbox_config));
+    }
+}
+
+ShardedEventBus::~ShardedEventBus() = default;
+
+QueueConfig ShardedEventBus::default_inbox_config() {
+    QueueConfig config;
+    config.mode = QueueMode::LockFree;
+    return config;
+}
+
+size_t ShardedEventBus::shard_count() const {
+    return shards_.size();
+}
+
+ShardId ShardedEventBus::shard_for(uint64_t key) const {
+    return static_cast<ShardId>(key % shards_.size());
+}
+
+const std::unique_ptr<EventDispatcher>& ShardedEventBus::checked(ShardId shard) const {
+    if (shard >= shards_.size()) {
+        throw std::out_of_range("Unknown shard");
+    }
+    return shards_[shard];
+}
+
+EventDispatcher& ShardedEventBus::shard(ShardId shard) {
+    return *checked(shard);
+}
+
+void ShardedEventBus::bind_current_thread(ShardId shard) {
+    checked(shard);
+    current_binding = ShardBinding{instance_id_, shard};
+}
+
+void ShardedEventBus::unbind_current_thread() {
+    if (current_binding.bus_id == instance_id_) {
+        current_binding = ShardBinding();
+    }
+}
+
+std::optional<ShardId> ShardedEventBus::current_shard() const {
+    if (current_binding.bus_id == instance_id_) {
+        return current_binding.shard;
+    }
+    return std::nullopt;
+}
+
+EventDispatcher& ShardedEventBus::local() {
+    if (current_binding.bus_id != instance_id_) {
+        throw std::logic_error("Thread is not bound to a shard of this bus");
+    }
+    return *shards_[current_binding.shard];
+}
+
+HandlerId ShardedEventBus::subscribe(const std::string& event_type, EventHandler handler, int priority) {
+    auto shared = std::make_shared<EventHandler>(std::move(handler));
+
+    std::vector<std::pair<ShardId, HandlerId>> replicas;
+    replicas.reserve(shards_.size());
+    for (ShardId shard = 0; shard < shards_.size(); ++shard) {
+        HandlerId local_id = shards_[shard]->subscribe(event_type,
+            [shared](Event& event) { (*shared)(event); }, priority);
+        replicas.emplace_back(shard, local_id);
+    }
+
+    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+    HandlerId id = next_id_++;
+    subscriptions_.emplace(id, std::move(replicas));
+    return id;
+}
+
+HandlerId ShardedEventBus::subscribe(ShardId shard, const std::string& event_type, EventHandler handler,
+                                     int priority) {
+    HandlerId local_id = checked(shard)->subscribe(event_type, std::move(handler), priority);
+
+    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+    HandlerId id = next_id_++;
+    subscriptions_.emplace(id, std::vector<std::pair<ShardId, HandlerId>>{{shard, local_id}});
+    return id;
+}
+
+void ShardedEventBus::unsubscribe(HandlerId id) {
+    std::vector<std::pair<ShardId, HandlerId>> replicas;
+    {
+        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+        auto it = subscriptions_.find(id);
+        if (it == subscriptions_.end()) return;
+        replicas = std::move(it->second);
+        subscriptions_.erase(it);
+    }
+    for (const auto& [shard, local_id] : replicas) {
+        shards_[shard]->unsubscribe(local_id);
+    }
+}
+
+bool ShardedEventBus::post(ShardId shard, std::unique_ptr<Event> event) {
+    return checked(shard)->queue_event(std::move(event));
+}
+
+bool ShardedEventBus::post_keyed(uint64_t key, std::unique_ptr<Event> event) {
+    return shards_[shard_for(key)]->queue_event(std::move(event));
+}
+
+size_t ShardedEventBus::broadcast(const Event& event) {
+    size_t delivered = 0;
+    for (auto& shard : shards_) {
+        if (shard->queue_event(event.clone())) {
+            ++delivered;
+        }
+    }
+    return delivered;
+}
+
+void ShardedEventBus::dispatch_local(Event& event) {
+    local().dispatch(event);
+}
+
+void ShardedEventBus::process(ShardId shard) {
+    checked(shard)->process_queue();
+}
+
+void ShardedEventBus::process_local() {
+    local().process_queue();
+}
+
+size_t ShardedEventBus::pending_events(ShardId shard) const {
+    return checked(shard)->pending_events();
+}
+
+}  // namespace temp2::events
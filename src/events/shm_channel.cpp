@@ -0,0 +1,353 @@
+#include "events/shm_channel.hpp"
+#include <bit>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <variant>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace temp2::events {
+
+namespace {
+
+using shm_channel::SegmentHeader;
+using shm_channel::WireEvent;
+using shm_channel::WireKind;
+
+// POSIX shared-memory names are a single path component starting with '/'
+std::string segment_name(const std::string& name) {
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+std::optional<WireKind> wire_kind(const Event& event) {
+    if (dynamic_cast<const MouseEvent*>(&event)) return WireKind::Mouse;
+    if (dynamic_cast<const KeyboardEvent*>(&event)) return WireKind::Keyboard;
+    if (dynamic_cast<const WindowEvent*>(&event)) return WireKind::Window;
+    if (dynamic_cast<const CustomEvent*>(&event)) return WireKind::Custom;
+    return std::nullopt;
+}
+
+size_t segment_size(uint64_t capacity) {
+    return sizeof(SegmentHeader) + static_cast<size_t>(capacity) * sizeof(WireEvent);
+}
+
+}  // namespace
+
+// =============================================================================
+// ShmEventProducer
+// =============================================================================
+
+ShmEventProducer::ShmEventProducer(const std::string& name, size_t capacity)
+    : name_(segment_name(name))
+    , mapping_(nullptr)
+    , mapping_size_(0)
+    , head_(0)
+    , cached_tail_(0)
+    , posted_(0)
+    , dropped_(0)
+    , payload_key_(attribute_key_registry().intern(PAYLOAD_KEY))
+    , dispatcher_(nullptr)
+    , observer_id_(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Shared memory channel capacity must be positive");
+    }
+    capacity = std::bit_ceil(capacity);
+    mask_ = capacity - 1;
+
+    // A segment left behind by a crashed producer is replaced
+    ::shm_unlink(name_.c_str());
+    int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create shared memory channel: " + name_);
+    }
+
+    mapping_size_ = segment_size(capacity);
+    if (::ftruncate(fd, static_cast<off_t>(mapping_size_)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Cannot size shared memory channel: " + name_);
+    }
+    void* mapping = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Cannot map shared memory channel: " + name_);
+    }
+    mapping_ = mapping;
+
+    header_ = new (mapping_) SegmentHeader();
+    std::memcpy(header_->magic, shm_channel::MAGIC, sizeof(shm_channel::MAGIC));
+    header_->version = shm_channel::FORMAT_VERSION;
+    header_->slot_size = sizeof(WireEvent);
+    header_->capacity = capacity;
+    slots_ = reinterpret_cast<WireEvent*>(static_cast<char*>(mapping_) + sizeof(SegmentHeader));
+    header_->ready.store(1, std::memory_order_release);
+}
+
+ShmEventProducer::~ShmEventProducer() {
+    detach();
+    ::munmap(mapping_, mapping_size_);
+    ::shm_unlink(name_.c_str());
+}
+
+bool ShmEventProducer::post(const Event& event) {
+    std::optional<WireKind> kind = wire_kind(event);
+    if (!kind) {
+        throw std::invalid_argument("Event has no shared memory layout: " + event.type());
+    }
+    return encode(event, *kind, true);
+}
+
+bool ShmEventProducer::encode(const Event& event, WireKind kind, bool strict) {
+    // post() tells its caller about events that cannot travel or find no
+    // room; the observer has nobody to tell, so it counts them as dropped
+    auto reject = [&](const auto& error) {
+        if (strict) throw error;
+        ++dropped_;
+        return false;
+    };
+
+    const std::string* payload = nullptr;
+    if (kind == WireKind::Custom) {
+        const auto& custom = static_cast<const CustomEvent&>(event);
+        if (custom.name().size() > shm_channel::NAME_CAPACITY) {
+            return reject(std::length_error("Custom event name too long for shared memory channel"));
+        }
+        if (const AttributeValue* value = custom.attributes().find(payload_key_)) {
+            payload = std::get_if<std::string>(&value->storage());
+            if (!payload) {
+                return reject(std::invalid_argument("Custom event payload must be a string"));
+            }
+            if (payload->size() > shm_channel::PAYLOAD_CAPACITY) {
+                return reject(std::length_error("Custom event payload too long for shared memory channel"));
+            }
+        }
+    }
+
+    if (head_ - cached_tail_ > mask_) {
+        cached_tail_ = header_->tail.load(std::memory_order_acquire);
+        if (head_ - cached_tail_ > mask_) {
+            if (!strict) ++dropped_;  // post() callers may retry
+            return false;
+        }
+    }
+
+    // Encoded in place; the slot is invisible to the consumer until head moves
+    WireEvent& wire = slots_[head_ & mask_];
+    wire.kind = kind;
+    switch (kind) {
+        case WireKind::Mouse: {
+            const auto& mouse = static_cast<const MouseEvent&>(event);
+            wire.mouse.action = static_cast<uint8_t>(mouse.action());
+            wire.mouse.button = static_cast<uint8_t>(mouse.button());
+            wire.mouse.x = mouse.x();
+            wire.mouse.y = mouse.y();
+            wire.mouse.scroll_delta = mouse.scroll_delta();
+            break;
+        }
+        case WireKind::Keyboard: {
+            const auto& keyboard = static_cast<const KeyboardEvent&>(event);
+            wire.keyboard.action = static_cast<uint8_t>(keyboard.action());
+            wire.keyboard.key_code = keyboard.key_code();
+            wire.keyboard.modifiers = keyboard.modifiers();
+            break;
+        }
+        case WireKind::Window: {
+            const auto& window = static_cast<const WindowEvent&>(event);
+            wire.window.action = static_cast<uint8_t>(window.action());
+            wire.window.width = window.width();
+            wire.window.height = window.height();
+            wire.window.x = window.x();
+            wire.window.y = window.y();
+            break;
+        }
+        case WireKind::Custom: {
+            const auto& custom = static_cast<const CustomEvent&>(event);
+            wire.custom.name_size = static_cast<uint8_t>(custom.name().size());
+            std::memcpy(wire.custom.name, custom.name().data(), custom.name().size());
+            wire.custom.payload_size = static_cast<uint16_t>(payload ? payload->size() : 0);
+            if (payload) {
+                std::memcpy(wire.custom.payload, payload->data(), payload->size());
+            }
+            break;
+        }
+    }
+
+    header_->head.store(++head_, std::memory_order_release);
+    ++posted_;
+    return true;
+}
+
+void ShmEventProducer::attach(EventDispatcher& dispatcher) {
+    detach();
+    dispatcher_ = &dispatcher;
+    observer_id_ = dispatcher.add_observer(
+        [this](const Event& event) {
+            if (std::optional<WireKind> kind = wire_kind(event)) {
+                encode(event, *kind, false);
+            }
+        },
+        [this] {
+            dispatcher_ = nullptr;
+            observer_id_ = 0;
+        });
+}
+
+void ShmEventProducer::detach() {
+    if (dispatcher_) {
+        dispatcher_->remove_observer(observer_id_);
+        dispatcher_ = nullptr;
+        observer_id_ = 0;
+    }
+}
+
+const std::string& ShmEventProducer::name() const {
+    return name_;
+}
+
+size_t ShmEventProducer::capacity() const {
+    return static_cast<size_t>(mask_ + 1);
+}
+
+size_t ShmEventProducer::posted() const {
+    return posted_;
+}
+
+size_t ShmEventProducer::dropped() const {
+    return dropped_;
+}
+
+// =============================================================================
+// ShmEventConsumer
+// =============================================================================
+
+ShmEventConsumer::ShmEventConsumer(const std::string& name)
+    : mapping_(nullptr)
+    , mapping_size_(0)
+    , skipped_(0)
+    , payload_key_(attribute_key_registry().intern(ShmEventProducer::PAYLOAD_KEY)) {
+    const std::string path = segment_name(name);
+    int fd = ::shm_open(path.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open shared memory channel: " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SegmentHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not an event channel: " + path);
+    }
+    mapping_size_ = static_cast<size_t>(info.st_size);
+
+    void* mapping = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map shared memory channel: " + path);
+    }
+    mapping_ = mapping;
+    header_ = static_cast<SegmentHeader*>(mapping_);
+
+    const uint64_t capacity = header_->capacity;
+    if (header_->ready.load(std::memory_order_acquire) != 1 ||
+        std::memcmp(header_->magic, shm_channel::MAGIC, sizeof(shm_channel::MAGIC)) != 0 ||
+        header_->version != shm_channel::FORMAT_VERSION || header_->slot_size != sizeof(WireEvent) ||
+        !std::has_single_bit(capacity) || mapping_size_ < segment_size(capacity)) {
+        ::munmap(mapping_, mapping_size_);
+        throw std::runtime_error("Not an event channel: " + path);
+    }
+
+    slots_ = reinterpret_cast<const WireEvent*>(static_cast<char*>(mapping_) + sizeof(SegmentHeader));
+    mask_ = capacity - 1;
+    tail_ = header_->tail.load(std::memory_order_relaxed);
+}
+
+ShmEventConsumer::~ShmEventConsumer() {
+    ::munmap(mapping_, mapping_size_);
+}
+
+size_t ShmEventConsumer::poll(EventDispatcher& dispatcher, size_t max_events) {
+    const uint64_t head = header_->head.load(std::memory_order_acquire);
+    size_t consumed = 0;
+    while (tail_ != head && consumed < max_events) {
+        if (!dispatch_slot(slots_[tail_ & mask_], dispatcher)) {
+            ++skipped_;
+        }
+        ++consumed;
+    }
+    return consumed;
+}
+
+bool ShmEventConsumer::dispatch_slot(const WireEvent& wire, EventDispatcher& dispatcher) {
+    // Each case decodes onto the stack and frees the slot before dispatching,
+    // so the producer can reuse it while handlers run
+    auto release = [this] { header_->tail.store(++tail_, std::memory_order_release); };
+
+    switch (wire.kind) {
+        case WireKind::Mouse: {
+            MouseEvent event(static_cast<MouseEvent::Action>(wire.mouse.action), wire.mouse.x, wire.mouse.y,
+                             static_cast<MouseEvent::Button>(wire.mouse.button));
+            event.set_scroll_delta(wire.mouse.scroll_delta);
+            release();
+            dispatcher.dispatch(event);
+            return true;
+        }
+        case WireKind::Keyboard: {
+            KeyboardEvent event(static_cast<KeyboardEvent::Action>(wire.keyboard.action), wire.keyboard.key_code,
+                                wire.keyboard.modifiers);
+            release();
+            dispatcher.dispatch(event);
+            return true;
+        }
+        case WireKind::Window: {
+            // WindowEvent carries either a size or a position
+            const auto action = static_cast<WindowEvent::Action>(wire.window.action);
+            const shm_channel::WindowFields fields = wire.window;
+            release();
+            if (fields.width != 0 || fields.height != 0) {
+                WindowEvent event(action, fields.width, fields.height);
+                dispatcher.dispatch(event);
+            } else if (fields.x != 0 || fields.y != 0) {
+                WindowEvent event(action, fields.x, fields.y, true);
+                dispatcher.dispatch(event);
+            } else {
+                WindowEvent event(action);
+                dispatcher.dispatch(event);
+            }
+            return true;
+        }
+        case WireKind::Custom: {
+            const size_t name_size = wire.custom.name_size;
+            const size_t payload_size = wire.custom.payload_size;
+            if (name_size > shm_channel::NAME_CAPACITY || payload_size > shm_channel::PAYLOAD_CAPACITY) {
+                break;
+            }
+            CustomEvent event(std::string(wire.custom.name, name_size));
+            if (payload_size > 0) {
+                event.set_data(payload_key_, std::string(wire.custom.payload, payload_size));
+            }
+            release();
+            dispatcher.dispatch(event);
+            return true;
+        }
+    }
+    release();
+    return false;
+}
+
+size_t ShmEventConsumer::pending() const {
+    return static_cast<size_t>(header_->head.load(std::memory_order_acquire) - tail_);
+}
+
+size_t ShmEventConsumer::capacity() const {
+    return static_cast<size_t>(mask_ + 1);
+}
+
+size_t ShmEventConsumer::skipped() const {
+    return skipped_;
+}
+
+}  // namespace temp2::events
@@ -0,0 +1,209 @@
+#include "events/timer_wheel.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace temp2::events {
+
+// =============================================================================
+// TimerWheel
+// =============================================================================
+
+TimerWheel::TimerWheel(Duration resolution, Clock::time_point origin)
+    : resolution_(resolution), origin_(origin), current_tick_(0), active_(0) {
+    if (resolution_ <= Duration::zero()) {
+        throw std::invalid_argument("Timer resolution must be positive");
+    }
+    slots_.fill(NONE);
+}
+
+uint64_t TimerWheel::to_tick(Clock::time_point time) const {
+    if (time <= origin_) return 0;
+    // Round up so a timer never fires before its deadline
+    auto ticks = (time - origin_ + resolution_ - Duration(1)) / resolution_;
+    return static_cast<uint64_t>(ticks);
+}
+
+size_t TimerWheel::slot_for(uint64_t expires) const {
+    uint64_t delta = expires - current_tick_;
+    if (delta < LEVEL0_SLOTS) {
+        return static_cast<size_t>(expires & (LEVEL0_SLOTS - 1));
+    }
+
+    for (size_t level = 1; level < LEVELS; ++level) {
+        size_t shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+        bool last = level + 1 == LEVELS;
+        if (delta < (uint64_t{1} << (shift + LEVEL_BITS)) || last) {
+            if (last && delta >= (uint64_t{1} << (shift + LEVEL_BITS))) {
+                // Beyond the wheel: park in the farthest slot and re-file on cascade
+                expires = current_tick_ + (uint64_t{1} << (shift + LEVEL_BITS)) - 1;
+            }
+            return LEVEL0_SLOTS + (level - 1) * LEVEL_SLOTS +
+                   static_cast<size_t>((expires >> shift) & (LEVEL_SLOTS - 1));
+        }
+    }
+    return 0;  // Unreachable
+}
+
+void TimerWheel::link(uint32_t index) {
+    Timer& timer = timers_[index];
+    size_t slot = slot_for(timer.expires);
+    timer.slot = static_cast<uint32_t>(slot);
+    timer.prev = NONE;
+    timer.next = slots_[slot];
+    if (timer.next != NONE) {
+        timers_[timer.next].prev = index;
+    }
+    slots_[slot] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Timer& timer = timers_[index];
+    if (timer.prev != NONE) {
+        timers_[timer.prev].next = timer.next;
+    } else {
+        slots_[timer.slot] = timer.next;
+    }
+    if (timer.next != NONE) {
+        timers_[timer.next].prev = timer.prev;
+    }
+    timer.prev = NONE;
+    timer.next = NONE;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Timer& timer = timers_[index];
+    timer.task = TimerTask();
+    timer.slot = NONE;
+    if (++timer.generation == 0) {
+        timer.generation = 1;
+    }
+    free_.push_back(index);
+    --active_;
+}
+
+TimerId TimerWheel::schedule(Clock::time_point deadline, TimerTask task, Duration period) {
+    if (!task.event && !task.callback) {
+        throw std::invalid_argument("Timer task needs an event or a callback");
+    }
+    if (period > Duration::zero() && task.event) {
+        throw std::invalid_argument("Periodic timers need a callback");
+    }
+
+    uint32_t index;
+    if (!free_.empty()) {
+        index = free_.back();
+        free_.pop_back();
+    } else {
+        if (timers_.size() >= NONE) {
+            throw std::length_error("Too many timers");
+        }
+        index = static_cast<uint32_t>(timers_.size());
+        timers_.emplace_back();
+    }
+
+    Timer& timer = timers_[index];
+    timer.expires = std::max(to_tick(deadline), current_tick_);
+    timer.period = 0;
+    if (period > Duration::zero()) {
+        timer.period = std::max<uint64_t>(1, static_cast<uint64_t>((period + resolution_ - Duration(1)) / resolution_));
+    }
+    timer.task = std::move(task);
+    link(index);
+    ++active_;
+
+    return (static_cast<uint64_t>(timer.generation) << 32) | index;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    if (!is_pending(id)) return false;
+    auto index = static_cast<uint32_t>(id);
+    unlink(index);
+    release(index);
+    return true;
+}
+
+bool TimerWheel::is_pending(TimerId id) const {
+    auto index = static_cast<uint32_t>(id);
+    auto generation = static_cast<uint32_t>(id >> 32);
+    return index < timers_.size() && timers_[index].generation == generation &&
+           timers_[index].slot != NONE;
+}
+
+void TimerWheel::clear() {
+    for (uint32_t index = 0; index < timers_.size(); ++index) {
+        if (timers_[index].slot != NONE) {
+            release(index);
+        }
+    }
+    slots_.fill(NONE);
+}
+
+void TimerWheel::cascade(size_t level) {
+    size_t shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+    size_t slot = LEVEL0_SLOTS + (level - 1) * LEVEL_SLOTS +
+                  static_cast<size_t>((current_tick_ >> shift) & (LEVEL_SLOTS - 1));
+
+    uint32_t index = slots_[slot];
+    slots_[slot] = NONE;
+    while (index != NONE) {
+        uint32_t next = timers_[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+void TimerWheel::expire_slot(size_t slot, std::vector<TimerTask>& expired) {
+    while (slots_[slot] != NONE) {
+        uint32_t index = slots_[slot];
+        unlink(index);
+
+        Timer& timer = timers_[index];
+        if (timer.period > 0) {
+            expired.push_back(TimerTask{nullptr, timer.task.callback});
+            timer.expires = current_tick_ + timer.period;
+            link(index);
+        } else {
+            expired.push_back(std::move(timer.task));
+            release(index);
+        }
+    }
+}
+
+size_t TimerWheel::advance(Clock::time_point now, std::vector<TimerTask>& expired) {
+    if (now < origin_) return 0;
+    const uint64_t target = static_cast<uint64_t>((now - origin_) / resolution_);
+    const size_t before = expired.size();
+
+    while (current_tick_ <= target) {
+        if (active_ == 0) {
+            // Nothing to fire or cascade: jump straight to the target
+            current_tick_ = target + 1;
+            break;
+        }
+
+        // Refill lower levels from the next level up whenever they wrap
+        for (size_t level = 1; level < LEVELS; ++level) {
+            size_t shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+            if ((current_tick_ & ((uint64_t{1} << shift) - 1)) != 0) break;
+            cascade(level);
+        }
+
+        expire_slot(static_cast<size_t>(current_tick_ & (LEVEL0_SLOTS - 1)), expired);
+        ++current_tick_;
+    }
+    return expired.size() - before;
+}
+
+size_t TimerWheel::size() const {
+    return active_;
+}
+
+bool TimerWheel::empty() const {
+    return active_ == 0;
+}
+
+TimerWheel::Duration TimerWheel::resolution() const {
+    return resolution_;
+}
+
+}  // namespace temp2::events
@@ -0,0 +1,281 @@
+#include "events/worker_pool.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace temp2::events {
+
+// =============================================================================
+// DispatchWorkerPool
+// =============================================================================
+
+DispatchWorkerPool::DispatchWorkerPool(size_t thread_count, const QueueConfig& lane_config,
+                                       DispatchFunc dispatch)
+    : dispatch_(std::move(dispatch))
+    , stopping_(false)
+    , submitted_(0)
+    , processed_(0) {
+    thread_count = std::max<size_t>(thread_count, 1);
+
+    lanes_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        lanes_.push_back(std::make_unique<Lane>(lane_config));
+    }
+
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(*lanes_[i]); });
+    }
+}
+
+DispatchWorkerPool::~DispatchWorkerPool() {
+    shutdown(false);
+}
+
+bool DispatchWorkerPool::submit(std::unique_ptr<Event> event) {
+    EventTypeId route = event ? event->type_id() : 0;
+    return submit(std::move(event), route);
+}
+
+bool DispatchWorkerPool::submit(std::unique_ptr<Event> event, EventTypeId route) {
+    if (!event || stopping_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    Lane& lane = *lanes_[route % lanes_.size()];
+
+    // Counted before the push so a worker can never finish an uncounted event
+    submitted_.fetch_add(1, std::memory_order_seq_cst);
+    bool queued;
+    try {
+        queued = lane.queue.push(std::move(event));
+    } catch (...) {
+        submitted_.fetch_sub(1, std::memory_order_seq_cst);
+        throw;
+    }
+
+    if (queued) {
+        wake(lane);
+    } else {
+        notify_if_idle();
+    }
+    return queued;
+}
+
+bool DispatchWorkerPool::try_submit(std::unique_ptr<Event>& event) {
+    return try_submit(event, event ? event->type_id() : 0);
+}
+
+bool DispatchWorkerPool::try_submit(std::unique_ptr<Event>& event, EventTypeId route) {
+    if (!event || stopping_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    Lane& lane = *lanes_[route % lanes_.size()];
+
+    submitted_.fetch_add(1, std::memory_order_seq_cst);
+    if (!lane.queue.try_push(event)) {
+        submitted_.fetch_sub(1, std::memory_order_seq_cst);
+        return false;
+    }
+    wake(lane);
+    return true;
+}
+
+void DispatchWorkerPool::wake(Lane& lane) {
+    // Pairs with the fence in worker_loop: either the worker sees the new
+    // event before sleeping or we see it sleeping and notify
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (lane.sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        lane.wake.notify_one();
+    }
+}
+
+void DispatchWorkerPool::worker_loop(Lane& lane) {
+    EventQueue::ConsumerScope consumer;
+    const size_t batch_size = lane.queue.config().batch_size;
+    std::vector<std::unique_ptr<Event>> batch;
+    std::vector<Event*> events;
+    batch.reserve(batch_size);
+    events.reserve(batch_size);
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        size_t count = lane.queue.pop_batch(batch, batch_size);
+        if (count > 0) {
+            for (auto& event : batch) {
+                events.push_back(event.get());
+            }
+            dispatch_(events);
+            events.clear();
+            batch.clear();
+            processed_.fetch_add(count, std::memory_order_seq_cst);
+            notify_if_idle();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(lane.mutex);
+        lane.sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        lane.wake.wait(lock, [this, &lane] {
+            return stopping_.load(std::memory_order_acquire) || !lane.queue.empty();
+        });
+        lane.sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool DispatchWorkerPool::is_idle() const {
+    size_t completed = processed_.load(std::memory_order_seq_cst);
+    for (const auto& lane : lanes_) {
+        completed += lane->queue.dropped();
+    }
+    return completed >= submitted_.load(std::memory_order_seq_cst);
+}
+
+void DispatchWorkerPool::notify_if_idle() {
+    if (is_idle()) {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_.notify_all();
+    }
+}
+
+void DispatchWorkerPool::drain() {
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    // Timed wait guards against a wakeup racing with a drop on a full lane
+    while (!is_idle() && !threads_.empty()) {
+        idle_.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+void DispatchWorkerPool::shutdown(bool drain_pending) {
+    if (drain_pending) {
+        drain();
+    }
+
+    stopping_.store(true, std::memory_order_release);
+    for (auto& lane : lanes_) {
+        std::lock_guard<std::mutex> lock(lane->mutex);
+        lane->wake.notify_all();
+    }
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+
+    for (auto& lane : lanes_) {
+        lane->queue.clear();
+    }
+}
+
+size_t DispatchWorkerPool::thread_count() const {
+    return lanes_.size();
+}
+
+size_t DispatchWorkerPool::pending() const {
+    size_t total = 0;
+    for (const auto& lane : lanes_) {
+        total += lane->queue.size();
+    }
+    return total;
+}
+
+bool DispatchWorkerPool::running() const {
+    return !stopping_.load(std::memory_order_acquire);
+}
+
+// =============================================================================
+// FanOutPool
+// =============================================================================
+
+FanOutPool::FanOutPool(size_t thread_count) : job_(nullptr), generation_(0), stopping_(false) {
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+FanOutPool::~FanOutPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t FanOutPool::thread_count() const {
+    return threads_.size();
+}
+
+void FanOutPool::run_tasks(size_t count, Invoke invoke, void* context) {
+    std::unique_lock<std::mutex> fanning_out(run_mutex_, std::try_to_lock);
+    if (!fanning_out.owns_lock() || count < 2 || threads_.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            invoke(context, i);
+        }
+        return;
+    }
+
+    Job job;
+    job.invoke = invoke;
+    job.context = context;
+    job.count = count;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        ++generation_;
+    }
+    work_available_.notify_all();
+
+    work(job);
+
+    {
+        // Once the job is withdrawn no worker can join it; wait for the ones inside
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_ = nullptr;
+        job_left_.wait(lock, [&job] { return job.participants == 0; });
+    }
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+void FanOutPool::work(Job& job) {
+    for (size_t i = job.next.fetch_add(1, std::memory_order_relaxed); i < job.count;
+         i = job.next.fetch_add(1, std::memory_order_relaxed)) {
+        try {
+            job.invoke(job.context, i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.error_mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+    }
+}
+
+void FanOutPool::worker_loop() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_available_.wait(lock, [this, &seen] {
+            return stopping_ || (job_ && generation_ != seen);
+        });
+        if (stopping_) return;
+
+        seen = generation_;
+        Job& job = *job_;
+        ++job.participants;
+        lock.unlock();
+        work(job);
+        lock.lock();
+        if (--job.participants == 0) {
+            job_left_.notify_all();
+        }
+    }
+}
+
+}  // namespace temp2::events